@@ -0,0 +1,156 @@
+//
+// Convert a plotfile with compressed variables (castro.compress_vars)
+// into a standard plotfile holding all of the variables.
+//
+#include <cstring>
+#include <iostream>
+
+#include <AMReX.H>
+#include <AMReX_FileSystem.H>
+#include <AMReX_PlotFileUtil.H>
+
+#include <Castro_compress.H>
+
+using namespace amrex;
+
+//
+// Prototypes
+//
+void GetInputArgs (const int argc, char** argv,
+                   std::string& pltfile, std::string& outfile);
+
+void PrintHelp ();
+
+
+int main(int argc, char* argv[])
+{
+
+    amrex::Initialize(argc, argv, false);
+
+    {
+        BL_PROFILE("main()");
+
+        std::string pltfile, outfile;
+
+        GetInputArgs(argc, argv, pltfile, outfile);
+
+        PlotFileData pf(pltfile);
+
+        const int finest_level = pf.finestLevel();
+        const int nlevels = finest_level + 1;
+
+        Vector<std::string> var_names = pf.varNames();
+
+        Vector<MultiFab> level_data(nlevels);
+        Vector<Geometry> geoms(nlevels);
+        Vector<int> level_steps(nlevels);
+        Vector<IntVect> ref_ratio(finest_level);
+
+        const RealBox rb(pf.probLo(), pf.probHi());
+        const Array<int, AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0, 0, 0)};
+
+        for (int lev = 0; lev <= finest_level; ++lev) {
+
+            const BoxArray& ba = pf.boxArray(lev);
+            const DistributionMapping& dm = pf.DistributionMap(lev);
+
+            MultiFab standard = pf.get(lev);
+
+            // The compressed variables, if any, live alongside the
+            // Cell MultiFab in the level directory.
+
+            const std::string level_dir = pltfile + "/Level_" + std::to_string(lev);
+
+            MultiFab compressed;
+            Vector<std::string> compressed_names;
+
+            if (FileSystem::Exists(level_dir + "/Compressed_H")) {
+                read_compressed_level(level_dir, ba, dm, compressed, compressed_names);
+            }
+
+            if (lev == 0) {
+                for (const auto& name : compressed_names) {
+                    var_names.push_back(name);
+                }
+            }
+
+            const int nstandard = standard.nComp();
+            const int ncompressed = compressed_names.size();
+
+            if (nstandard + ncompressed != static_cast<int>(var_names.size())) {
+                amrex::Abort("Compressed variables differ between levels");
+            }
+
+            level_data[lev].define(ba, dm, nstandard + ncompressed, 0);
+
+            MultiFab::Copy(level_data[lev], standard, 0, 0, nstandard, 0);
+            if (ncompressed > 0) {
+                MultiFab::Copy(level_data[lev], compressed, 0, nstandard, ncompressed, 0);
+            }
+
+            geoms[lev].define(pf.probDomain(lev), rb, pf.coordSys(), is_periodic);
+            level_steps[lev] = pf.levelStep(lev);
+
+            if (lev < finest_level) {
+                ref_ratio[lev] = IntVect(pf.refRatio(lev));
+            }
+
+            Print() << "level " << lev << ": " << nstandard << " standard and "
+                    << ncompressed << " compressed variables" << std::endl;
+        }
+
+        WriteMultiLevelPlotfile(outfile, nlevels, GetVecOfConstPtrs(level_data),
+                                var_names, geoms, pf.time(), level_steps, ref_ratio);
+    }
+
+    amrex::Finalize();
+
+}
+
+
+
+void GetInputArgs (const int argc, char** argv,
+                   std::string& pltfile, std::string& outfile)
+{
+
+    int i = 1; // skip program name
+
+    while (i < argc)
+    {
+
+        if (!strcmp(argv[i], "-p") || !strcmp(argv[i], "--pltfile"))
+        {
+            pltfile = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-o") || !strcmp(argv[i], "--outfile"))
+        {
+            outfile = argv[++i];
+        }
+        else
+        {
+            std::cout << "\n\nOption " << argv[i] << " not recognized" << std::endl;
+            PrintHelp();
+            exit(EXIT_FAILURE);
+        }
+
+        // Go to the next parameter name
+        ++i;
+    }
+
+    if (pltfile.empty() || outfile.empty())
+    {
+        PrintHelp();
+        Abort("Missing input or output file");
+    }
+
+}
+
+
+
+void PrintHelp ()
+{
+    Print() << "\nusage: executable_name args"
+            << "\nargs [-p|--pltfile] plotfile : plot file directory   (required)"
+            << "\n     [-o|--outfile] outfile  : expanded plot file    (required)"
+            << "\n\n" << std::endl;
+}
@@ -89,12 +89,24 @@ Castro::wd_update (Real time, Real dt)
     Real old_mass_P = mass_P;
     Real old_mass_S = mass_S;
 
+    // We compute the stellar masses, centers of mass and velocities, the
+    // volumes of the stars above each of the density cutoffs 10**i
+    // (i = 0, ..., 6), and the extrema on the grid, all in one pass over
+    // the state data on each level. The fine mask and the stellar masks
+    // are evaluated on the fly.
+
     ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
               ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
-              ReduceOpSum, ReduceOpSum> reduce_op;
+              ReduceOpSum, ReduceOpSum,
+              ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+              ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+              ReduceOpMax, ReduceOpMax, ReduceOpMax> reduce_op;
     ReduceData<Real, Real, Real, Real, Real, Real,
                Real, Real, Real, Real, Real, Real,
-               Real, Real> reduce_data(reduce_op);
+               Real, Real,
+               Real, Real, Real, Real, Real, Real, Real,
+               Real, Real, Real, Real, Real, Real, Real,
+               Real, Real, Real> reduce_data(reduce_op);
     using ReduceTuple = typename decltype(reduce_data)::Type;
 
     for (int lev = 0; lev <= parent->finestLevel(); lev++) {
@@ -120,48 +132,45 @@ Castro::wd_update (Real time, Real dt)
           }
       }
 
-      // Density and momenta
-
-      auto mfrho  = c_lev.derive("density",time,0);
-      auto mfxmom = c_lev.derive("xmom",time,0);
-      auto mfymom = c_lev.derive("ymom",time,0);
-      auto mfzmom = c_lev.derive("zmom",time,0);
-
-      // Masks for the primary and secondary
-
-      auto mfpmask = c_lev.derive("primarymask", time, 0);
-      auto mfsmask = c_lev.derive("secondarymask", time, 0);
-
-      BL_ASSERT(mfrho   != nullptr);
-      BL_ASSERT(mfxmom  != nullptr);
-      BL_ASSERT(mfymom  != nullptr);
-      BL_ASSERT(mfzmom  != nullptr);
-      BL_ASSERT(mfpmask != nullptr);
-      BL_ASSERT(mfsmask != nullptr);
+      const MultiFab& S = c_lev.get_data(State_Type, time);
+#ifdef ROTATION
+      const MultiFab& phirot = c_lev.get_data(PhiRot_Type, time);
+#endif
+#ifdef REACTIONS
+      const MultiFab& R = c_lev.get_data(Reactions_Type, time);
+      const int enuc_comp = NumSpec + NumAux;
+
+      Real dd = 0.0_rt;
+#if AMREX_SPACEDIM == 1
+      dd = dx[0];
+#elif AMREX_SPACEDIM == 2
+      dd = amrex::min(dx[0], dx[1]);
+#else
+      dd = amrex::min(dx[0], dx[1], dx[2]);
+#endif
+#endif
 
-      if (lev < parent->finestLevel())
-      {
-          const MultiFab& mask = getLevel(lev+1).build_fine_mask();
+      const bool use_mask = lev < parent->finestLevel();
 
-          MultiFab::Multiply(*mfrho,   mask, 0, 0, 1, 0);
-          MultiFab::Multiply(*mfxmom,  mask, 0, 0, 1, 0);
-          MultiFab::Multiply(*mfymom,  mask, 0, 0, 1, 0);
-          MultiFab::Multiply(*mfzmom,  mask, 0, 0, 1, 0);
-          MultiFab::Multiply(*mfpmask, mask, 0, 0, 1, 0);
-          MultiFab::Multiply(*mfsmask, mask, 0, 0, 1, 0);
-      }
+      const MultiFab* mask = use_mask ? &getLevel(lev+1).build_fine_mask() : nullptr;
 
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-      for (MFIter mfi(*mfrho, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-          auto rho   = (*mfrho )[mfi].array();
-          auto xmom  = (*mfxmom)[mfi].array();
-          auto ymom  = (*mfymom)[mfi].array();
-          auto zmom  = (*mfzmom)[mfi].array();
-          auto pmask = (*mfpmask)[mfi].array();
-          auto smask = (*mfsmask)[mfi].array();
+      for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+          auto U     = S[mfi].array();
           auto vol   = c_lev.volume[mfi].array();
+#ifdef ROTATION
+          auto phi   = phirot[mfi].array();
+#endif
+#ifdef REACTIONS
+          auto react = R[mfi].array();
+#endif
+
+          Array4<Real const> msk;
+          if (use_mask) {
+              msk = mask->array(mfi);
+          }
 
           const Box& box  = mfi.tilebox();
 
@@ -174,6 +183,15 @@ Castro::wd_update (Real time, Real dt)
           reduce_op.eval(box, reduce_data,
           [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
           {
+              // Zones covered by a finer level do not contribute.
+
+              Real fine_factor = 1.0_rt;
+              if (use_mask) {
+                  fine_factor = msk(i,j,k);
+              }
+
+              const Real rho = U(i,j,k,URHO);
+
               // Add to the COM locations and velocities of the primary and secondary
               // depending on which potential dominates, ignoring unbound material.
               // Note that in this routine we actually are summing mass-weighted
@@ -202,10 +220,12 @@ Castro::wd_update (Real time, Real dt)
                   }
               }
 
-              Real dm = rho(i,j,k) * vol(i,j,k);
+              Real dm = rho * vol(i,j,k) * fine_factor;
 
               Real dmSymmetric = dm;
-              GpuArray<Real, 3> momSymmetric{xmom(i,j,k), ymom(i,j,k), zmom(i,j,k)};
+              GpuArray<Real, 3> momSymmetric{U(i,j,k,UMX) * fine_factor,
+                                             U(i,j,k,UMY) * fine_factor,
+                                             U(i,j,k,UMZ) * fine_factor};
 
               if (coord_type == 0) {
 
@@ -232,15 +252,37 @@ Castro::wd_update (Real time, Real dt)
 
               }
 
+              // The stellar masks are evaluated at the zone center.
+
+              GpuArray<Real, 3> loc;
+              loc[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0];
+#if AMREX_SPACEDIM >= 2
+              loc[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1];
+#else
+              loc[1] = 0.0_rt;
+#endif
+#if AMREX_SPACEDIM == 3
+              loc[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2];
+#else
+              loc[2] = 0.0_rt;
+#endif
+
+              Real phi_rot = 0.0_rt;
+#ifdef ROTATION
+              phi_rot = phi(i,j,k);
+#endif
+
+              const int star = star_index(loc, rho, phi_rot);
+
               Real primary_factor = 0.0_rt;
               Real secondary_factor = 0.0_rt;
 
-              if (pmask(i,j,k) > 0.0_rt) {
+              if (star == 1) {
 
                   primary_factor = 1.0_rt;
 
               }
-              else if (smask(i,j,k) > 0.0_rt) {
+              else if (star == 2) {
 
                   secondary_factor = 1.0_rt;
 
@@ -265,22 +307,71 @@ Castro::wd_update (Real time, Real dt)
               Real m_P = dmSymmetric * primary_factor;
               Real m_S = dmSymmetric * secondary_factor;
 
+              // Volume of the stars above each of the density cutoffs
+              // used for the effective radii.
+
+              Real v_P[7];
+              Real v_S[7];
+
+              Real rho_cutoff = 1.0_rt;
+
+              for (int n = 0; n <= 6; ++n) {
+                  Real above = (rho > rho_cutoff) ? vol(i,j,k) * fine_factor : 0.0_rt;
+                  v_P[n] = above * primary_factor;
+                  v_S[n] = above * secondary_factor;
+                  rho_cutoff *= 10.0_rt;
+              }
+
+              // Extrema on the grid.
+
+              Real T_max = U(i,j,k,UTEMP) * fine_factor;
+              Real rho_max = rho * fine_factor;
+              Real ts_te_max = 0.0_rt;
+
+#ifdef REACTIONS
+              // This is the same as the t_sound_t_enuc derived variable.
+
+              Real enuc = std::abs(react(i,j,k,enuc_comp)) / rho;
+
+              if (fine_factor > 0.0_rt && enuc > 1.e-100_rt) {
+
+                  Real rhoInv = 1.0_rt / rho;
+
+                  eos_t eos_state;
+                  eos_state.rho = rho;
+                  eos_state.T = U(i,j,k,UTEMP);
+                  eos_state.e = U(i,j,k,UEINT) * rhoInv;
+                  for (int n = 0; n < NumSpec; n++) {
+                      eos_state.xn[n] = U(i,j,k,UFS+n) * rhoInv;
+                  }
+#if NAUX_NET > 0
+                  for (int n = 0; n < NumAux; n++) {
+                      eos_state.aux[n] = U(i,j,k,UFX+n) * rhoInv;
+                  }
+#endif
+
+                  eos(eos_input_re, eos_state);
+
+                  Real t_e = eos_state.e / enuc;
+                  Real t_s = dd / eos_state.cs;
+
+                  ts_te_max = t_s / t_e;
+
+              }
+#endif
+
               return {com_P_x, com_P_y, com_P_z, com_S_x, com_S_y, com_S_z,
                       vel_P_x, vel_P_y, vel_P_z, vel_S_x, vel_S_y, vel_S_z,
-                      m_P, m_S};
+                      m_P, m_S,
+                      v_P[0], v_P[1], v_P[2], v_P[3], v_P[4], v_P[5], v_P[6],
+                      v_S[0], v_S[1], v_S[2], v_S[3], v_S[4], v_S[5], v_S[6],
+                      T_max, rho_max, ts_te_max};
           });
 
       }
 
     }
 
-    // Compute effective radii of stars at various density cutoffs
-
-    bool local_flag = true;
-
-    for (int i = 0; i <= 6; ++i)
-        Castro::volInBoundary(time, vol_P[i], vol_S[i], pow(10.0,i), local_flag);
-
     // Do all of the reductions.
 
     ReduceTuple hv = reduce_data.value();
@@ -300,6 +391,25 @@ Castro::wd_update (Real time, Real dt)
     mass_P   = amrex::get<12>(hv);
     mass_S   = amrex::get<13>(hv);
 
+    vol_P[0] = amrex::get<14>(hv);
+    vol_P[1] = amrex::get<15>(hv);
+    vol_P[2] = amrex::get<16>(hv);
+    vol_P[3] = amrex::get<17>(hv);
+    vol_P[4] = amrex::get<18>(hv);
+    vol_P[5] = amrex::get<19>(hv);
+    vol_P[6] = amrex::get<20>(hv);
+    vol_S[0] = amrex::get<21>(hv);
+    vol_S[1] = amrex::get<22>(hv);
+    vol_S[2] = amrex::get<23>(hv);
+    vol_S[3] = amrex::get<24>(hv);
+    vol_S[4] = amrex::get<25>(hv);
+    vol_S[5] = amrex::get<26>(hv);
+    vol_S[6] = amrex::get<27>(hv);
+
+    T_curr_max     = amrex::get<28>(hv);
+    rho_curr_max   = amrex::get<29>(hv);
+    ts_te_curr_max = amrex::get<30>(hv);
+
     const int nfoo_sum = 28;
     Real foo_sum[nfoo_sum] = { 0.0 };
 
@@ -335,6 +445,19 @@ Castro::wd_update (Real time, Real dt)
       vel_S[i] = foo_sum[i+25];
     }
 
+    const int nfoo_max = 3;
+    Real foo_max[nfoo_max];
+
+    foo_max[0] = T_curr_max;
+    foo_max[1] = rho_curr_max;
+    foo_max[2] = ts_te_curr_max;
+
+    amrex::ParallelDescriptor::ReduceRealMax(foo_max, nfoo_max);
+
+    T_curr_max     = foo_max[0];
+    rho_curr_max   = foo_max[1];
+    ts_te_curr_max = foo_max[2];
+
     // Compute effective WD radii
 
     for (int i = 0; i <= 6; ++i) {
@@ -397,109 +520,6 @@ Castro::wd_update (Real time, Real dt)
 
 
 
-// This function uses the known center of mass of the two white dwarfs,
-// and given a density cutoff, computes the total volume of all zones
-// whose density is greater or equal to that density cutoff.
-// We also impose a distance requirement so that we only look
-// at zones that are within twice the original radius of the white dwarf.
-
-void Castro::volInBoundary (Real time, Real& vol_P, Real& vol_S, Real rho_cutoff, bool local)
-{
-    BL_PROFILE("Castro::volInBoundary()");
-
-    using namespace wdmerger;
-    using namespace problem;
-
-    BL_ASSERT(level == 0);
-
-    vol_P = 0.0;
-    vol_S = 0.0;
-
-    for (int lev = 0; lev <= parent->finestLevel(); lev++) {
-
-      Castro& c_lev = getLevel(lev);
-
-      const auto dx = c_lev.geom.CellSizeArray();
-      auto mf = c_lev.derive("density",time,0);
-
-      // Effective potentials of the primary and secondary
-
-      auto mfpmask = c_lev.derive("primarymask", time, 0);
-      auto mfsmask = c_lev.derive("secondarymask", time, 0);
-
-      BL_ASSERT(mf      != nullptr);
-      BL_ASSERT(mfpmask != nullptr);
-      BL_ASSERT(mfsmask != nullptr);
-
-      if (lev < parent->finestLevel())
-      {
-	  const MultiFab& mask = c_lev.getLevel(lev+1).build_fine_mask();
-	  MultiFab::Multiply(*mf,      mask, 0, 0, 1, 0);
-	  MultiFab::Multiply(*mfpmask, mask, 0, 0, 1, 0);
-	  MultiFab::Multiply(*mfsmask, mask, 0, 0, 1, 0);
-      }
-
-      ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
-      ReduceData<Real, Real> reduce_data(reduce_op);
-      using ReduceTuple = typename decltype(reduce_data)::Type;
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-      for (MFIter mfi(*mf, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-          auto rho   = (*mf)[mfi].array();
-          auto pmask = (*mfpmask)[mfi].array();
-          auto smask = (*mfsmask)[mfi].array();
-          auto vol   = c_lev.volume[mfi].array();
-
-	  const Box& box  = mfi.tilebox();
-
-          // This function uses the known center of mass of the two white dwarfs,
-          // and given a density cutoff, computes the total volume of all zones
-          // whose density is greater or equal to that density cutoff.
-          // We also impose a distance requirement so that we only look
-          // at zones within the Roche lobe of the white dwarf.
-
-          reduce_op.eval(box, reduce_data,
-          [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
-          {
-              Real primary_factor = 0.0_rt;
-              Real secondary_factor = 0.0_rt;
-
-              if (rho(i,j,k) > rho_cutoff) {
-
-                  if (pmask(i,j,k) > 0.0_rt) {
-
-                      primary_factor = 1.0_rt;
-
-                  }
-                  else if (smask(i,j,k) > 0.0_rt) {
-
-                      secondary_factor = 1.0_rt;
-
-                  }
-
-              }
-
-              return {vol(i,j,k) * primary_factor, vol(i,j,k) * secondary_factor};
-          });
-
-      }
-
-      ReduceTuple hv = reduce_data.value();
-
-      vol_P += amrex::get<0>(hv);
-      vol_S += amrex::get<1>(hv);
-
-    }
-
-    if (!local)
-      amrex::ParallelDescriptor::ReduceRealSum({vol_P, vol_S});
-
-}
-
-
-
 // Computes standard dot-product of two three-vectors.
 
 Real Castro::dot_product(const Real a[], const Real b[]) {
@@ -773,57 +793,11 @@ void Castro::update_extrema(Real time) {
     using namespace wdmerger;
     using namespace problem;
 
-    // Compute extrema
-
-    bool local_flag = true;
-
-    T_curr_max     = 0.0;
-    rho_curr_max   = 0.0;
-    ts_te_curr_max = 0.0;
-
-    int finest_level = parent->finestLevel();
-
-    for (int lev = 0; lev <= finest_level; lev++) {
-
-      auto T = parent->getLevel(lev).derive("Temp", time, 0);
-      auto rho = parent->getLevel(lev).derive("density", time, 0);
-#ifdef REACTIONS
-      auto ts_te = parent->getLevel(lev).derive("t_sound_t_enuc", time, 0);
-#endif
-
-      if (lev < finest_level) {
-          const MultiFab& mask = getLevel(lev+1).build_fine_mask();
-          MultiFab::Multiply(*T, mask, 0, 0, 1, 0);
-          MultiFab::Multiply(*rho, mask, 0, 0, 1, 0);
-#ifdef REACTIONS
-          MultiFab::Multiply(*ts_te, mask, 0, 0, 1, 0);
-#endif
-      }
-
-      T_curr_max = std::max(T_curr_max, T->max(0, 0, local_flag));
-      rho_curr_max = std::max(rho_curr_max, rho->max(0, 0, local_flag));
+    amrex::ignore_unused(time);
 
-#ifdef REACTIONS
-      ts_te_curr_max = std::max(ts_te_curr_max, ts_te->max(0, 0, local_flag));
-#endif
-
-    }
-
-    // Max reductions
-
-    const int nfoo_max = 3;
-
-    Real foo_max[3];
-
-    foo_max[0] = T_curr_max;
-    foo_max[1] = rho_curr_max;
-    foo_max[2] = ts_te_curr_max;
-
-    amrex::ParallelDescriptor::ReduceRealMax(foo_max, nfoo_max);
-
-    T_curr_max     = foo_max[0];
-    rho_curr_max   = foo_max[1];
-    ts_te_curr_max = foo_max[2];
+    // The extrema at the current time (T_curr_max, rho_curr_max, and
+    // ts_te_curr_max) are computed alongside the white dwarf data in
+    // wd_update, so all that is left is to update the global maxima.
 
     T_global_max     = std::max(T_global_max, T_curr_max);
     rho_global_max   = std::max(rho_global_max, rho_curr_max);
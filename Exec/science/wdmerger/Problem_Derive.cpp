@@ -566,15 +566,6 @@ void ca_derprimarymask(const Box& bx, FArrayBox& derfab, int dcomp, int /*ncomp*
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
     {
-        // By default, assume we're not inside the star.
-
-        der(i,j,k,0) = -1.0_rt;
-
-        // Don't do anything here if the star no longer exists,
-        // or if it never existed.
-
-        if (problem::mass_P <= 0.0_rt) return;
-
         GpuArray<Real, 3> loc;
         loc[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0];
 
@@ -590,23 +581,10 @@ void ca_derprimarymask(const Box& bx, FArrayBox& derfab, int dcomp, int /*ncomp*
         loc[2] = 0.0_rt;
 #endif
 
-        // Ignore zones whose density is too low.
-
-        if (dat(i,j,k,0) < problem::stellar_density_threshold) return;
-
-        Real r_P = std::sqrt((loc[0] - problem::com_P[0]) * (loc[0] - problem::com_P[0]) +
-                             (loc[1] - problem::com_P[1]) * (loc[1] - problem::com_P[1]) +
-                             (loc[2] - problem::com_P[2]) * (loc[2] - problem::com_P[2]));
-
-        Real r_S = std::sqrt((loc[0] - problem::com_S[0]) * (loc[0] - problem::com_S[0]) +
-                             (loc[1] - problem::com_S[1]) * (loc[1] - problem::com_S[1]) +
-                             (loc[2] - problem::com_S[2]) * (loc[2] - problem::com_S[2]));
-
-        Real phi_p = -C::Gconst * problem::mass_P / r_P + dat(i,j,k,1);
-        Real phi_s = -C::Gconst * problem::mass_S / r_S + dat(i,j,k,1);
-
-        if (phi_p < 0.0_rt && phi_p < phi_s) {
+        if (star_index(loc, dat(i,j,k,0), dat(i,j,k,1)) == 1) {
             der(i,j,k,0) = 1.0_rt;
+        } else {
+            der(i,j,k,0) = -1.0_rt;
         }
     });
 }
@@ -626,15 +604,6 @@ void ca_dersecondarymask(const Box& bx, FArrayBox& derfab, int dcomp, int /*ncom
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
     {
-        // By default, assume we're not inside the star.
-
-        der(i,j,k,0) = -1.0_rt;
-
-        // Don't do anything here if the star no longer exists,
-        // or if it never existed.
-
-        if (problem::mass_S <= 0.0_rt) return;
-
         GpuArray<Real, 3> loc;
         loc[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0];
 
@@ -650,23 +619,10 @@ void ca_dersecondarymask(const Box& bx, FArrayBox& derfab, int dcomp, int /*ncom
         loc[2] = 0.0_rt;
 #endif
 
-        // Ignore zones whose density is too low.
-
-        if (dat(i,j,k,0) < problem::stellar_density_threshold) return;
-
-        Real r_P = std::sqrt((loc[0] - problem::com_P[0]) * (loc[0] - problem::com_P[0]) +
-                             (loc[1] - problem::com_P[1]) * (loc[1] - problem::com_P[1]) +
-                             (loc[2] - problem::com_P[2]) * (loc[2] - problem::com_P[2]));
-
-        Real r_S = std::sqrt((loc[0] - problem::com_S[0]) * (loc[0] - problem::com_S[0]) +
-                             (loc[1] - problem::com_S[1]) * (loc[1] - problem::com_S[1]) +
-                             (loc[2] - problem::com_S[2]) * (loc[2] - problem::com_S[2]));
-
-        Real phi_p = -C::Gconst * problem::mass_P / r_P + dat(i,j,k,1);
-        Real phi_s = -C::Gconst * problem::mass_S / r_S + dat(i,j,k,1);
-
-        if (phi_s < 0.0_rt && phi_s < phi_p) {
+        if (star_index(loc, dat(i,j,k,0), dat(i,j,k,1)) == 2) {
             der(i,j,k,0) = 1.0_rt;
+        } else {
+            der(i,j,k,0) = -1.0_rt;
         }
     });
 }
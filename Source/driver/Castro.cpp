@@ -64,6 +64,8 @@
 #include <problem_tagging.H>
 
 #include <ambient.H>
+#include <timestep.H>
+#include <Castro_bc_fill_nd.H>
 
 using namespace amrex;
 
@@ -77,10 +79,15 @@ BCRec        Castro::phys_bc;
 int          Castro::NUM_GROW      = -1;
 
 int          Castro::lastDtPlotLimited = 0;
+bool         Castro::load_balance_pending = false;
 Real         Castro::lastDtBeforePlotLimiting = 0.0;
 
 Real         Castro::num_zones_advanced = 0.0;
 
+Long         Castro::num_riemann_smooth = 0;
+Long         Castro::num_riemann_weak = 0;
+Long         Castro::num_riemann_strong = 0;
+
 Vector<std::string> Castro::source_names;
 
 Vector<AMRErrorTag> Castro::custom_error_tags;
@@ -88,6 +95,8 @@ Vector<AMRErrorTag> Castro::custom_error_tags;
 Vector<std::unique_ptr<std::fstream>> Castro::data_logs;
 Vector<std::unique_ptr<std::fstream>> Castro::problem_data_logs;
 
+Vector<Real> Castro::problem_integrals;
+
 #ifdef TRUE_SDC
 int          Castro::SDC_NODES;
 Vector<Real> Castro::dt_sdc;
@@ -159,6 +168,11 @@ int          Castro::do_init_probparams = 0;
 void
 Castro::variableCleanUp ()
 {
+  // Make sure any output still being written in the background is on
+  // disk before we tear anything down.
+
+  flush_async_output();
+
 #ifdef GRAVITY
   if (gravity != 0) {
     if (verbose > 1 && ParallelDescriptor::IOProcessor()) {
@@ -416,6 +430,23 @@ Castro::read_params ()
         amrex::Error();
       }
 
+    if (load_balance_type < 0 || load_balance_type > 2) {
+        amrex::Error("castro.load_balance_type must be 0, 1, or 2");
+    }
+
+    // the separate passive advection is only implemented in the CTU hydro
+    if (split_passive_advection == 1 &&
+        time_integration_method != CornerTransportUpwind &&
+        time_integration_method != SimplifiedSpectralDeferredCorrections) {
+        amrex::Error("castro.split_passive_advection requires CTU or simplified SDC time advancement");
+    }
+
+#ifdef MHD
+    if (split_passive_advection == 1) {
+        amrex::Error("castro.split_passive_advection is not supported with MHD");
+    }
+#endif
+
 #ifdef AMREX_PARTICLES
     read_particle_params();
 #endif
@@ -435,6 +466,12 @@ Castro::read_params ()
     if (do_radiation && time_integration_method != CornerTransportUpwind) {
         amrex::Error("Radiation is currently only supported for CTU time advancement.");
     }
+
+    // the radiation object keeps per-level data that is not safe to
+    // rebuild outside of a regrid
+    if (do_radiation && load_balance_type > 0) {
+        amrex::Error("castro.load_balance_type > 0 is not supported with radiation");
+    }
 #endif
 
 #ifdef ROTATION
@@ -1225,22 +1262,7 @@ Castro::initData ()
            Sborder.define(grids, dmap, NUM_STATE, NUM_GROW);
            AmrLevel::FillPatch(*this, Sborder, NUM_GROW, cur_time, State_Type, 0, NUM_STATE);
 
-           // note: this cannot be tiled
-           auto domain_lo = geom.Domain().loVect3d();
-           auto domain_hi = geom.Domain().hiVect3d();
-
-           FArrayBox tmp;
-
-           for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
-             {
-               const Box& box = mfi.validbox();
-
-               tmp.resize(box, 1);
-               Elixir elix_tmp = tmp.elixir();
-               auto tmp_arr = tmp.array();
-
-               make_fourth_in_place(box, Sborder.array(mfi), tmp_arr, domain_lo, domain_hi);
-             }
+           make_fourth_in_place(Sborder, 0);
 
            // now copy back the averages
            MultiFab::Copy(S_new, Sborder, 0, 0, NUM_STATE, 0);
@@ -1252,25 +1274,14 @@ Castro::initData ()
          Sborder.define(grids, dmap, NUM_STATE, NUM_GROW);
          AmrLevel::FillPatch(*this, Sborder, NUM_GROW, cur_time, State_Type, 0, NUM_STATE);
 
-         // convert to centers -- not tile safe
-         auto domain_lo = geom.Domain().loVect3d();
-         auto domain_hi = geom.Domain().hiVect3d();
-
-         FArrayBox tmp;
-
-         for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
-           {
-             const Box& box = mfi.growntilebox(2);
-
-             tmp.resize(box, 1);
-             Elixir elix_tmp = tmp.elixir();
-             auto tmp_arr = tmp.array();
-
-             make_cell_center_in_place(box, Sborder.array(mfi), tmp_arr, domain_lo, domain_hi);
-           }
+         // convert to centers
+         make_cell_center_in_place(Sborder, 2);
 
          // reset the energy -- do this in one ghost cell so we can average in place below
-         for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+         for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
            {
              const Box& box = mfi.growntilebox(1);
 
@@ -1306,17 +1317,8 @@ Castro::initData ()
              });
            }
 
-         // convert back to averages -- not tile safe
-         for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
-           {
-             const Box& box = mfi.validbox();
-
-             tmp.resize(box, 1);
-             Elixir elix_tmp = tmp.elixir();
-             auto tmp_arr = tmp.array();
-
-             make_fourth_in_place(box, Sborder.array(mfi), tmp_arr, domain_lo, domain_hi);
-           }
+         // convert back to averages
+         make_fourth_in_place(Sborder, 0);
 
          // now copy back the averages for UEINT and UTEMP only
          MultiFab::Copy(S_new, Sborder, UEINT, UEINT, 1, 0);
@@ -1620,7 +1622,11 @@ Castro::estTimeStep ()
 #ifdef MHD
           estdt_hydro = estdt_mhd();
 #else
-          estdt_hydro = estdt_cfl(time);
+          if (estdt_fused_valid) {
+              estdt_hydro = estdt_cfl_fused;
+          } else {
+              estdt_hydro = estdt_cfl(time);
+          }
 #endif
 
 #ifdef RADIATION
@@ -1651,7 +1657,11 @@ Castro::estTimeStep ()
 
     if (diffuse_temp)
     {
-      estdt_diffusion = estdt_temp_diffusion();
+      if (estdt_fused_valid) {
+          estdt_diffusion = estdt_diffusion_fused;
+      } else {
+          estdt_diffusion = estdt_temp_diffusion();
+      }
     }
 
     ParallelDescriptor::ReduceRealMin(estdt_diffusion);
@@ -1676,7 +1686,11 @@ Castro::estTimeStep ()
 
         // Compute burning-limited timestep.
 
-        estdt_burn = estdt_burning();
+        if (estdt_fused_valid) {
+            estdt_burn = estdt_burning_fused;
+        } else {
+            estdt_burn = estdt_burning();
+        }
 
         ParallelDescriptor::ReduceRealMin(estdt_burn);
 
@@ -2007,13 +2021,15 @@ Castro::post_timestep (int iteration_local)
 #endif
 
     // Clean up any aberrant state data generated by the reflux and average-down,
-    // and then update quantities like temperature to be consistent.
+    // and then update quantities like temperature to be consistent.  This is
+    // the last update to the state this step, so we can have it compute the
+    // timestep limits for the next step as it goes.
     MultiFab& S_new = get_new_data(State_Type);
     clean_state(
 #ifdef MHD
                 Bx_new, By_new, Bz_new,
 #endif
-                S_new, state[State_Type].curTime(), S_new.nGrow());
+                S_new, state[State_Type].curTime(), S_new.nGrow(), true);
 
 
     // Flush Fortran output
@@ -2069,6 +2085,10 @@ Castro::post_timestep (int iteration_local)
         if (moving_center) {
           write_center();
         }
+
+        if (verbose && hse_cache == 1) {
+          print_hse_cache_stats();
+        }
 #endif
     }
 
@@ -2095,6 +2115,12 @@ Castro::post_timestep (int iteration_local)
 
             TimestampParticles(ngrow+1);
         }
+
+        if (level == 0 && particles::history_interval > 0 &&
+            parent->levelSteps(0) % particles::history_interval == 0)
+        {
+            WriteParticleHistory();
+        }
     }
 #endif
 }
@@ -2201,6 +2227,20 @@ Castro::postCoarseTimeStep (Real cumtime)
     if (do_grav)
         gravity->set_mass_offset(cumtime, 0);
 #endif
+
+    if (load_balance_type > 0) {
+
+        const int nstep = parent->levelSteps(0);
+
+        if (load_balance_pending || (load_balance_int > 0 && nstep % load_balance_int == 0)) {
+            load_balance_pending = false;
+
+            // This may replace this level, so nothing may follow it.
+
+            load_balance(parent);
+        }
+
+    }
 }
 
 void
@@ -2212,6 +2252,16 @@ Castro::post_regrid (int lbase,
 
     fine_mask.clear();
 
+    if (hse_cache == 1 && level == lbase) {
+        // the cached HSE boundary profiles are for the columns of the
+        // old grids
+        clear_hse_cache();
+    }
+
+    if (load_balance_type > 0) {
+        load_balance_pending = true;
+    }
+
 #ifdef AMREX_PARTICLES
     if (TracerPC && level == lbase) {
         TracerPC->Redistribute(lbase);
@@ -3929,12 +3979,55 @@ Castro::computeTemp(
                     MultiFab& Bz,
 #endif
 
-                    MultiFab& State, Real time, int ng)
+                    MultiFab& State, Real time, int ng, bool estimate_dt)
 
 {
 
   BL_PROFILE("Castro::computeTemp()");
 
+  // Any change to the new-time state invalidates the timestep limits
+  // from the last time we were here.  If requested, we recompute them
+  // below as we call the EOS, so that estTimeStep does not need
+  // another pass over the state.
+
+  const bool is_new_state = (&State == &get_new_data(State_Type));
+
+  if (is_new_state) {
+      estdt_fused_valid = false;
+  }
+
+  bool do_estdt = estimate_dt && is_new_state &&
+                  fuse_timestep_estimate == 1 && clamp_ambient_temp == 0;
+
+#ifdef TRUE_SDC
+  if (sdc_order == 4) {
+      do_estdt = false;
+  }
+#endif
+
+#if defined(MHD) || defined(RADIATION)
+  // these timestep limiters need more than the fluid EOS
+  do_estdt = false;
+#endif
+
+  ReduceOps<ReduceOpMin, ReduceOpMin, ReduceOpMin> reduce_op;
+  ReduceData<Real, Real, Real> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
+  const auto dx = geom.CellSizeArray();
+  GeometryData geomdata = geom.data();
+
+  const bool lestdt_hydro = do_hydro == 1;
+#ifdef DIFFUSION
+  const bool lestdt_diffusion = diffuse_temp == 1;
+  const Real ldiffuse_cutoff_density = diffuse_cutoff_density;
+#endif
+#ifdef REACTIONS
+  const bool lestdt_burning = do_react == 1 &&
+                              (castro::dtnuc_e <= 1.e199_rt || castro::dtnuc_X <= 1.e199_rt);
+#endif
+  const Real ldt_diffusion_default = max_dt / cfl;
+
   MultiFab Stemp;
 
   // for 4th order, the only variables that may change here are Temp
@@ -3966,24 +4059,20 @@ Castro::computeTemp(
     auto domain_lo = geom.Domain().loVect3d();
     auto domain_hi = geom.Domain().hiVect3d();
 
-    FArrayBox tmp;
-
-    for (MFIter mfi(Stemp); mfi.isValid(); ++mfi) {
-      const Box& bx = mfi.growntilebox(1);
+    // the Laplacian term needs to be computed from the averages,
+    // so it must be finished before any tile is converted in place
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(Stemp, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
       const Box& bx0 = mfi.tilebox();
-      const int idx = mfi.tileIndex();
 
       compute_lap_term(bx0, Stemp.array(mfi), Eint_lap.array(mfi), UEINT,
                        domain_lo, domain_hi);
-
-      tmp.resize(bx, 1);
-      Elixir elix_tmp = tmp.elixir();
-      auto tmp_arr = tmp.array();
-
-      make_cell_center_in_place(bx, Stemp.array(mfi), tmp_arr, domain_lo, domain_hi);
-
     }
 
+    make_cell_center_in_place(Stemp, 1);
+
   }
 #endif
 
@@ -4029,6 +4118,68 @@ Castro::computeTemp(
 
       Array4<Real> const u = u_fab.array();
 
+      if (do_estdt) {
+
+          // only the valid zones contribute to the timestep
+
+          const Box& vbx = mfi.tilebox();
+
+          reduce_op.eval(bx, reduce_data,
+          [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+          {
+
+              Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+
+              eos_t eos_state;
+
+              eos_state.rho = u(i,j,k,URHO);
+              eos_state.T   = u(i,j,k,UTEMP); // Initial guess for the EOS
+              eos_state.e   = u(i,j,k,UEINT) * rhoInv;
+              for (int n = 0; n < NumSpec; ++n) {
+                eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+              }
+#if NAUX_NET > 0
+              for (int n = 0; n < NumAux; ++n) {
+                eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+              }
+#endif
+
+              eos(eos_input_re, eos_state);
+
+              u(i,j,k,UTEMP) = eos_state.T;
+
+              Real dt_hydro = 1.e200_rt;
+              Real dt_diffusion = ldt_diffusion_default;
+              Real dt_burning = 1.e200_rt;
+
+              if (vbx.contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+
+                  if (lestdt_hydro) {
+                      dt_hydro = cfl_zone_dt(i, j, k, u, eos_state.cs, dx, geomdata, time);
+                  }
+
+#ifdef DIFFUSION
+                  if (lestdt_diffusion && eos_state.rho > ldiffuse_cutoff_density) {
+                      dt_diffusion = diffusion_zone_dt(eos_state, dx);
+                  }
+#endif
+
+#ifdef REACTIONS
+                  if (lestdt_burning) {
+                      dt_burning = burning_zone_dt(i, j, k, u);
+                  }
+#endif
+
+              }
+
+              return {dt_hydro, dt_diffusion, dt_burning};
+
+          });
+
+          continue;
+
+      }
+
       amrex::ParallelFor(bx,
       [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
       {
@@ -4086,23 +4237,8 @@ Castro::computeTemp(
     // cell-averages -- this is 4th-order and will be a no-op for
     // those zones where e wasn't changed.
 
-    auto domain_lo = geom.Domain().loVect3d();
-    auto domain_hi = geom.Domain().hiVect3d();
-
-    FArrayBox tmp;
-
-    for (MFIter mfi(Stemp); mfi.isValid(); ++mfi) {
-
-      const Box& bx = mfi.tilebox();
-      const int idx = mfi.tileIndex();
-
-      tmp.resize(bx, 1);
-      Elixir elix_tmp = tmp.elixir();
-      auto tmp_arr = tmp.array();
-
-      // only temperature
-      make_fourth_in_place_n(bx, Stemp.array(mfi), UTEMP, tmp_arr, domain_lo, domain_hi);
-    }
+    // only temperature
+    make_fourth_in_place_n(Stemp, UTEMP);
 
     // correct UEINT
     MultiFab::Add(Stemp, Eint_lap, 0, UEINT, 1, 0);
@@ -4122,6 +4258,14 @@ Castro::computeTemp(
   }
 #endif
 
+  if (do_estdt) {
+      ReduceTuple hv = reduce_data.value();
+      estdt_cfl_fused = amrex::get<0>(hv);
+      estdt_diffusion_fused = amrex::get<1>(hv);
+      estdt_burning_fused = amrex::get<2>(hv);
+      estdt_fused_valid = true;
+  }
+
 }
 
 
@@ -4274,91 +4418,46 @@ Castro::make_radial_data(int is_new)
 
    int numpts_1d = get_numpts();
 
-   Vector<Real> radial_vol(numpts_1d,0);
-
    const Real* dx = geom.CellSize();
    Real  dr = dx[0];
 
-   if (is_new == 1) {
-      MultiFab& S = get_new_data(State_Type);
-      const int nc = S.nComp();
-      Vector<Real> radial_state(numpts_1d*nc,0);
-      for (MFIter mfi(S); mfi.isValid(); ++mfi)
-      {
-         Box bx(mfi.validbox());
-         ca_compute_avgstate(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),ZFILL(dx),&dr,&nc,
-                             BL_TO_FORTRAN_ANYD(     S[mfi]),radial_state.dataPtr(),
-                             BL_TO_FORTRAN_ANYD(volume[mfi]),radial_vol.dataPtr(),
-                             ZFILL(geom.ProbLo()),&numpts_1d);
-      }
-
-      ParallelDescriptor::ReduceRealSum(radial_vol.dataPtr(),numpts_1d);
-      ParallelDescriptor::ReduceRealSum(radial_state.dataPtr(),numpts_1d*nc);
-
-      int first = 0;
-      int np_max = 0;
-      for (int i = 0; i < numpts_1d; i++) {
-         if (radial_vol[i] > 0.)
-         {
-            for (int j = 0; j < nc; j++) {
-              radial_state[nc*i+j] /= radial_vol[i];
-            }
-         } else if (first == 0) {
-            np_max = i;
-            first  = 1;
-         }
-      }
+   const MultiFab& S = (is_new == 1) ? get_new_data(State_Type) : get_old_data(State_Type);
+   const int nc = S.nComp();
 
-      Vector<Real> radial_state_short(np_max*nc,0);
+   GpuArray<Real, 3> ctr;
+   for (int n = 0; n < 3; ++n) {
+      ctr[n] = problem::center[n];
+   }
 
-      for (int i = 0; i < np_max; i++) {
-         for (int j = 0; j < nc; j++) {
-           radial_state_short[nc*i+j] = radial_state[nc*i+j];
-         }
-      }
+   Vector<Real> radial_state;
+   Vector<Real> radial_vol;
 
-      const Real new_time = state[State_Type].curTime();
-      set_new_outflow_data(radial_state_short.dataPtr(),&new_time,&np_max,&nc);
-   }
-   else
-   {
-      MultiFab& S = get_old_data(State_Type);
-      const int nc = S.nComp();
-      Vector<Real> radial_state(numpts_1d*nc,0);
-      for (MFIter mfi(S); mfi.isValid(); ++mfi)
-      {
-         Box bx(mfi.validbox());
-         ca_compute_avgstate(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),ZFILL(dx),&dr,&nc,
-                             BL_TO_FORTRAN_ANYD(     S[mfi]),radial_state.dataPtr(),
-                             BL_TO_FORTRAN_ANYD(volume[mfi]),radial_vol.dataPtr(),
-                             ZFILL(geom.ProbLo()),&numpts_1d);
-      }
+   compute_radial_average(S, 0, nc, ctr, dr, Vector<Real>(), numpts_1d, true,
+                          radial_state, radial_vol);
 
-      ParallelDescriptor::ReduceRealSum(radial_vol.dataPtr(),numpts_1d);
-      ParallelDescriptor::ReduceRealSum(radial_state.dataPtr(),numpts_1d*nc);
+   // The outflow data stops at the first empty shell.
 
-      int first = 0;
-      int np_max = 0;
-      for (int i = 0; i < numpts_1d; i++) {
-         if (radial_vol[i] > 0.)
-         {
-            for (int j = 0; j < nc; j++) {
-              radial_state[nc*i+j] /= radial_vol[i];
-            }
-         } else if (first == 0) {
-            np_max = i;
-            first  = 1;
-         }
+   int np_max = numpts_1d;
+   for (int i = 0; i < numpts_1d; i++) {
+      if (radial_vol[i] <= 0.) {
+         np_max = i;
+         break;
       }
+   }
 
-      Vector<Real> radial_state_short(np_max*nc,0);
+   Vector<Real> radial_state_short(np_max*nc,0);
 
-      for (int i = 0; i < np_max; i++) {
-         for (int j = 0; j < nc; j++) {
-           radial_state_short[nc*i+j] = radial_state[nc*i+j];
-         }
+   for (int i = 0; i < np_max; i++) {
+      for (int j = 0; j < nc; j++) {
+        radial_state_short[nc*i+j] = radial_state[nc*i+j];
       }
+   }
 
+   if (is_new == 1) {
+      const Real new_time = state[State_Type].curTime();
+      set_new_outflow_data(radial_state_short.dataPtr(),&new_time,&np_max,&nc);
+   }
+   else {
       const Real old_time = state[State_Type].prevTime();
       set_old_outflow_data(radial_state_short.dataPtr(),&old_time,&np_max,&nc);
    }
@@ -4543,7 +4642,7 @@ Castro::clean_state(
                     MultiFab& by,
                     MultiFab& bz,
 #endif
-                    MultiFab& state_in, Real time, int ng) {
+                    MultiFab& state_in, Real time, int ng, bool estimate_dt) {
 
     BL_PROFILE("Castro::clean_state()");
 
@@ -4574,7 +4673,7 @@ Castro::clean_state(
 #ifdef MHD
                 bx, by, bz,
 #endif
-                state_in, time, ng);
+                state_in, time, ng, estimate_dt);
 
 }
 
@@ -102,7 +102,10 @@ Castro::do_advance_sdc (Real time,
           // if we are 4th order, convert to cell-center Sborder -> Sborder_cc
           // we'll use Sburn for this memory buffer at the moment
 
-          for (MFIter mfi(S_new); mfi.isValid(); ++mfi) {
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+          for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
             const Box& gbx = mfi.growntilebox(1);
 
             make_cell_center(gbx, Sborder.array(mfi), Sburn.array(mfi), domain_lo, domain_hi);
@@ -120,18 +123,8 @@ Castro::do_advance_sdc (Real time,
           // the node time (time)
           AmrLevel::FillPatch(*this, old_source, old_source.nGrow(), prev_time, Source_Type, 0, NSRC);
 
-          // Now convert to cell averages.  This loop cannot be tiled.
-          FArrayBox tmp;
-
-          for (MFIter mfi(S_new); mfi.isValid(); ++mfi) {
-            const Box& bx = mfi.tilebox();
-
-            tmp.resize(bx, 1);
-            Elixir elix_tmp = tmp.elixir();
-            auto tmp_arr = tmp.array();
-
-            make_fourth_in_place(bx, old_source.array(mfi), tmp_arr, domain_lo, domain_hi);
-          }
+          // Now convert to cell averages.
+          make_fourth_in_place(old_source, 0);
 
         } else {
           // there is a ghost cell fill hidden in diffusion, so we need
@@ -307,57 +300,63 @@ Castro::do_advance_sdc (Real time,
     expand_state(Sborder, cur_time, 2);
   }
 
-  FArrayBox U_center;
-  FArrayBox R_center;
-  FArrayBox tmp;
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+  {
+    FArrayBox U_center;
+    FArrayBox R_center;
+    FArrayBox tmp;
 
-  // this cannot be tiled
-  for (MFIter mfi(R_new); mfi.isValid(); ++mfi) {
-    const Box& bx = mfi.tilebox();
-    const Box& obx = mfi.growntilebox(1);
+    // each tile converts its own copy of R, which it computes one
+    // zone beyond the tile, so this is tile safe
+    for (MFIter mfi(R_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+      const Box& bx = mfi.tilebox();
+      const Box& obx = mfi.growntilebox(1);
 
-    if (sdc_order == 4) {
+      if (sdc_order == 4) {
 
-      // convert S_new to cell-centers
-      U_center.resize(obx, NUM_STATE);
-      Elixir elix_u_center = U_center.elixir();
-      auto const U_center_arr = U_center.array();
+        // convert S_new to cell-centers
+        U_center.resize(obx, NUM_STATE);
+        Elixir elix_u_center = U_center.elixir();
+        auto const U_center_arr = U_center.array();
 
-      make_cell_center(obx, Sborder.array(mfi), U_center_arr, domain_lo, domain_hi);
+        make_cell_center(obx, Sborder.array(mfi), U_center_arr, domain_lo, domain_hi);
 
-      // pass in the reaction source and state at centers, including one ghost cell
-      // and derive everything that is needed including 1 ghost cell
-      R_center.resize(obx, R_new.nComp());
-      Elixir elix_r_center = R_center.elixir();
-      auto const R_center_arr = R_center.array();
+        // pass in the reaction source and state at centers, including one ghost cell
+        // and derive everything that is needed including 1 ghost cell
+        R_center.resize(obx, R_new.nComp());
+        Elixir elix_r_center = R_center.elixir();
+        auto const R_center_arr = R_center.array();
 
-      Array4<const Real> const Sburn_arr = Sburn.array(mfi);
+        Array4<const Real> const Sburn_arr = Sburn.array(mfi);
 
-      // we don't worry about the difference between centers and averages
-      ca_store_reaction_state(obx, Sburn_arr, U_center_arr, R_center_arr);
+        // we don't worry about the difference between centers and averages
+        ca_store_reaction_state(obx, Sburn_arr, U_center_arr, R_center_arr);
 
-      // convert R_new from centers to averages in place
-      tmp.resize(bx, 1);
-      Elixir elix_tmp = tmp.elixir();
-      auto const tmp_arr = tmp.array();
+        // convert R_new from centers to averages in place
+        tmp.resize(bx, 1);
+        Elixir elix_tmp = tmp.elixir();
+        auto const tmp_arr = tmp.array();
 
-      make_fourth_in_place(bx, R_center_arr, tmp_arr, domain_lo, domain_hi);
+        make_fourth_in_place(bx, R_center_arr, tmp_arr, domain_lo, domain_hi);
 
-      // store
-      R_new[mfi].copy(R_center, bx, 0, bx, 0, R_new.nComp());
+        // store
+        R_new[mfi].copy(R_center, bx, 0, bx, 0, R_new.nComp());
 
-    } else {
+      } else {
 
-      Array4<const Real> const R_old_arr = R_old[SDC_NODES-1]->array(mfi);
-      Array4<const Real> const S_new_arr = S_new.array(mfi);
-      Array4<Real> const R_new_arr = R_new.array(mfi);
-      // we don't worry about the difference between centers and averages
-      ca_store_reaction_state(bx,
-                              R_old_arr,
-                              S_new_arr,
-                              R_new_arr);
-    }
+        Array4<const Real> const R_old_arr = R_old[SDC_NODES-1]->array(mfi);
+        Array4<const Real> const S_new_arr = S_new.array(mfi);
+        Array4<Real> const R_new_arr = R_new.array(mfi);
+        // we don't worry about the difference between centers and averages
+        ca_store_reaction_state(bx,
+                                R_old_arr,
+                                S_new_arr,
+                                R_new_arr);
+      }
 
+    }
   }
 
   if (sdc_order == 4) {
@@ -0,0 +1,496 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <Castro_compress.H>
+
+using namespace amrex;
+
+namespace {
+
+    const std::string compressed_header_name("/Compressed_H");
+    const std::string compressed_data_name("/Compressed_D_");
+    const std::string compressed_version("CastroCompressed_V1");
+
+    void put_varint (std::uint64_t v, Vector<char>& out)
+    {
+        while (v >= 0x80) {
+            out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<char>(v));
+    }
+
+    std::uint64_t get_varint (const char*& p)
+    {
+        std::uint64_t v = 0;
+        int shift = 0;
+        unsigned char c;
+        do {
+            c = static_cast<unsigned char>(*p++);
+            v |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+            shift += 7;
+        } while (c & 0x80);
+        return v;
+    }
+
+    void put_double (double v, Vector<char>& out)
+    {
+        char b[sizeof(double)];
+        std::memcpy(b, &v, sizeof(double));
+        out.insert(out.end(), b, b + sizeof(double));
+    }
+
+    double get_double (const char*& p)
+    {
+        double v;
+        std::memcpy(&v, p, sizeof(double));
+        p += sizeof(double);
+        return v;
+    }
+
+    const char* mode_name (int mode)
+    {
+        switch (mode) {
+        case PlotLossless: return "lossless";
+        case PlotLossy:    return "lossy";
+        case PlotFloat32:  return "float32";
+        default:           return "none";
+        }
+    }
+
+    int mode_from_name (const std::string& name)
+    {
+        if (name == "lossless") return PlotLossless;
+        if (name == "lossy")    return PlotLossy;
+        if (name == "float32")  return PlotFloat32;
+        if (name == "none")     return PlotUncompressed;
+
+        amrex::Error("unknown plotfile compression type " + name);
+        return PlotUncompressed;
+    }
+
+}
+
+
+
+void
+get_plot_compress_specs (const Vector<std::string>& names,
+                         Vector<PlotCompressSpec>& specs)
+{
+    specs.clear();
+    specs.resize(names.size());
+
+    ParmParse pp("castro");
+
+    const int nvars = pp.countval("compress_vars");
+
+    if (nvars == 0) {
+        return;
+    }
+
+    Vector<std::string> vars;
+    Vector<std::string> types;
+    Vector<Real> tols(nvars, 0.0_rt);
+
+    pp.getarr("compress_vars", vars, 0, nvars);
+
+    if (pp.countval("compress_types") != nvars) {
+        amrex::Error("castro.compress_types must have one entry for each of castro.compress_vars");
+    }
+    pp.getarr("compress_types", types, 0, nvars);
+
+    if (pp.countval("compress_tols") > 0) {
+        if (pp.countval("compress_tols") != nvars) {
+            amrex::Error("castro.compress_tols must have one entry for each of castro.compress_vars");
+        }
+        pp.getarr("compress_tols", tols, 0, nvars);
+    }
+
+    for (int n = 0; n < nvars; ++n) {
+
+        const int mode = mode_from_name(types[n]);
+
+        if (mode == PlotLossy && tols[n] <= 0.0_rt) {
+            amrex::Error("castro.compress_tols must be positive for lossy variable " + vars[n]);
+        }
+
+        // Variables that are not in this plotfile are ignored.
+
+        for (int i = 0; i < names.size(); ++i) {
+            if (names[i] == vars[n]) {
+                specs[i].mode = mode;
+                specs[i].tol = tols[n];
+            }
+        }
+    }
+}
+
+
+
+void
+plot_compress_block (const Real* data, Long n,
+                     const PlotCompressSpec& spec, Vector<char>& out)
+{
+    if (spec.mode == PlotLossless) {
+
+        // XOR with the previous value; for smooth data the sign,
+        // exponent, and leading mantissa bytes are usually unchanged.
+        // A leading byte holds the number of zero bytes at the top
+        // (high nibble) and bottom (low nibble) of the XOR, and only
+        // the bytes in between are stored.
+
+        std::uint64_t prev = 0;
+
+        for (Long i = 0; i < n; ++i) {
+            const double v = static_cast<double>(data[i]);
+            std::uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(double));
+
+            const std::uint64_t x = bits ^ prev;
+            prev = bits;
+
+            if (x == 0) {
+                out.push_back(static_cast<char>(8 << 4));
+                continue;
+            }
+
+            int lz = 0;
+            while (((x >> (56 - 8 * lz)) & 0xff) == 0) {
+                ++lz;
+            }
+
+            int tz = 0;
+            while (((x >> (8 * tz)) & 0xff) == 0) {
+                ++tz;
+            }
+
+            out.push_back(static_cast<char>((lz << 4) | tz));
+
+            for (int b = tz; b < 8 - lz; ++b) {
+                out.push_back(static_cast<char>((x >> (8 * b)) & 0xff));
+            }
+        }
+
+    } else if (spec.mode == PlotLossy) {
+
+        // Predict each value from the previous reconstructed one and
+        // quantize the difference in steps of 2 tol, so the error is at
+        // most tol.  The quantized differences are stored as
+        // variable-length integers (zigzag encoded and offset by one);
+        // a zero marks a value that is stored exactly instead.
+
+        const double tol = spec.tol;
+        const double step = 2.0 * tol;
+
+        double pred = 0.0;
+
+        for (Long i = 0; i < n; ++i) {
+            const double v = static_cast<double>(data[i]);
+
+            bool quantized = false;
+            double recon = v;
+            std::int64_t q = 0;
+
+            if (std::isfinite(v)) {
+                const double dq = std::round((v - pred) / step);
+                if (std::abs(dq) < 1.e15) {
+                    q = static_cast<std::int64_t>(dq);
+                    recon = pred + step * static_cast<double>(q);
+                    quantized = std::abs(recon - v) <= tol;
+                }
+            }
+
+            if (quantized) {
+                const std::uint64_t zz = (static_cast<std::uint64_t>(q) << 1) ^
+                                         static_cast<std::uint64_t>(q >> 63);
+                put_varint(zz + 1, out);
+                pred = recon;
+            } else {
+                put_varint(0, out);
+                put_double(v, out);
+                pred = v;
+            }
+        }
+
+    } else if (spec.mode == PlotFloat32) {
+
+        for (Long i = 0; i < n; ++i) {
+            const float v = static_cast<float>(data[i]);
+            char b[sizeof(float)];
+            std::memcpy(b, &v, sizeof(float));
+            out.insert(out.end(), b, b + sizeof(float));
+        }
+
+    } else {
+
+        for (Long i = 0; i < n; ++i) {
+            put_double(static_cast<double>(data[i]), out);
+        }
+
+    }
+}
+
+
+
+void
+plot_decompress_block (const char* in, Long nbytes, Long n,
+                       const PlotCompressSpec& spec, Real* data)
+{
+    const char* p = in;
+
+    if (spec.mode == PlotLossless) {
+
+        std::uint64_t prev = 0;
+
+        for (Long i = 0; i < n; ++i) {
+            const unsigned char h = static_cast<unsigned char>(*p++);
+            const int lz = h >> 4;
+            const int tz = h & 0xf;
+
+            std::uint64_t x = 0;
+            if (lz < 8) {
+                for (int b = tz; b < 8 - lz; ++b) {
+                    x |= static_cast<std::uint64_t>(static_cast<unsigned char>(*p++)) << (8 * b);
+                }
+            }
+
+            const std::uint64_t bits = x ^ prev;
+            prev = bits;
+
+            double v;
+            std::memcpy(&v, &bits, sizeof(double));
+            data[i] = static_cast<Real>(v);
+        }
+
+    } else if (spec.mode == PlotLossy) {
+
+        const double step = 2.0 * spec.tol;
+
+        double pred = 0.0;
+
+        for (Long i = 0; i < n; ++i) {
+            const std::uint64_t u = get_varint(p);
+
+            double v;
+            if (u == 0) {
+                v = get_double(p);
+            } else {
+                const std::uint64_t zz = u - 1;
+                const std::int64_t q = static_cast<std::int64_t>(zz >> 1) ^ -static_cast<std::int64_t>(zz & 1);
+                v = pred + step * static_cast<double>(q);
+            }
+
+            pred = v;
+            data[i] = static_cast<Real>(v);
+        }
+
+    } else if (spec.mode == PlotFloat32) {
+
+        for (Long i = 0; i < n; ++i) {
+            float v;
+            std::memcpy(&v, p, sizeof(float));
+            p += sizeof(float);
+            data[i] = static_cast<Real>(v);
+        }
+
+    } else {
+
+        for (Long i = 0; i < n; ++i) {
+            data[i] = static_cast<Real>(get_double(p));
+        }
+
+    }
+
+    if (p - in != nbytes) {
+        amrex::Error("plot_decompress_block: corrupt compressed block");
+    }
+}
+
+
+
+void
+write_compressed_level (const MultiFab& mf,
+                        const Vector<std::string>& names,
+                        const Vector<PlotCompressSpec>& specs,
+                        const std::string& level_dir)
+{
+    BL_PROFILE("write_compressed_level()");
+
+    const int nvars = mf.nComp();
+    const int ngrids = mf.boxArray().size();
+
+    AMREX_ASSERT(names.size() == nvars && specs.size() == nvars);
+
+    const int myproc = ParallelDescriptor::MyProc();
+
+    // Where each block lives: the data file is identified by the rank
+    // that wrote it.
+
+    Vector<Long> offset(ngrids * nvars, 0);
+    Vector<Long> nbytes(ngrids * nvars, 0);
+    Vector<int> owner(ngrids, 0);
+
+    std::ofstream data_file;
+    Long file_pos = 0;
+
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        if (!data_file.is_open()) {
+            const std::string data_name = amrex::Concatenate(level_dir + compressed_data_name, myproc, 5);
+            data_file.open(data_name, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!data_file.good()) {
+                amrex::FileOpenFailed(data_name);
+            }
+        }
+
+        const int i = mfi.index();
+        const Box& bx = mfi.validbox();
+        const Long npts = bx.numPts();
+
+        FArrayBox host_fab(bx, nvars, The_Pinned_Arena());
+        host_fab.copy<RunOn::Device>(mf[mfi], bx, 0, bx, 0, nvars);
+        Gpu::streamSynchronize();
+
+        Vector<char> buf;
+
+        for (int n = 0; n < nvars; ++n) {
+            const Long start = buf.size();
+            plot_compress_block(host_fab.dataPtr(n), npts, specs[n], buf);
+            offset[i * nvars + n] = file_pos + start;
+            nbytes[i * nvars + n] = static_cast<Long>(buf.size()) - start;
+        }
+
+        data_file.write(buf.dataPtr(), buf.size());
+        file_pos += buf.size();
+
+        owner[i] = myproc;
+    }
+
+    if (data_file.is_open()) {
+        data_file.close();
+    }
+
+    const int ioproc = ParallelDescriptor::IOProcessorNumber();
+
+    ParallelDescriptor::ReduceLongSum(offset.dataPtr(), offset.size(), ioproc);
+    ParallelDescriptor::ReduceLongSum(nbytes.dataPtr(), nbytes.size(), ioproc);
+    ParallelDescriptor::ReduceIntSum(owner.dataPtr(), owner.size(), ioproc);
+
+    if (ParallelDescriptor::IOProcessor()) {
+
+        std::ofstream header(level_dir + compressed_header_name);
+        header << std::setprecision(17);
+
+        header << compressed_version << "\n";
+        header << nvars << "\n";
+        for (int n = 0; n < nvars; ++n) {
+            header << names[n] << " " << mode_name(specs[n].mode) << " " << specs[n].tol << "\n";
+        }
+
+        header << ngrids << "\n";
+        for (int i = 0; i < ngrids; ++i) {
+            header << mf.boxArray()[i] << " " << owner[i];
+            for (int n = 0; n < nvars; ++n) {
+                header << " " << offset[i * nvars + n] << " " << nbytes[i * nvars + n];
+            }
+            header << "\n";
+        }
+
+        if (!header.good()) {
+            amrex::Error("write_compressed_level: error writing " + level_dir + compressed_header_name);
+        }
+    }
+}
+
+
+
+void
+read_compressed_level (const std::string& level_dir,
+                       const BoxArray& ba,
+                       const DistributionMapping& dm,
+                       MultiFab& mf,
+                       Vector<std::string>& names)
+{
+    BL_PROFILE("read_compressed_level()");
+
+    Vector<char> header_chars;
+    ParallelDescriptor::ReadAndBcastFile(level_dir + compressed_header_name, header_chars);
+    std::istringstream header(header_chars.dataPtr());
+
+    std::string version;
+    header >> version;
+    if (version != compressed_version) {
+        amrex::Error("read_compressed_level: unknown format " + version);
+    }
+
+    int nvars;
+    header >> nvars;
+
+    names.resize(nvars);
+    Vector<PlotCompressSpec> specs(nvars);
+
+    for (int n = 0; n < nvars; ++n) {
+        std::string mode;
+        header >> names[n] >> mode >> specs[n].tol;
+        specs[n].mode = mode_from_name(mode);
+    }
+
+    int ngrids;
+    header >> ngrids;
+
+    if (ngrids != ba.size()) {
+        amrex::Error("read_compressed_level: BoxArray does not match " + level_dir);
+    }
+
+    Vector<Box> boxes(ngrids);
+    Vector<int> owner(ngrids);
+    Vector<Long> offset(ngrids * nvars);
+    Vector<Long> nbytes(ngrids * nvars);
+
+    for (int i = 0; i < ngrids; ++i) {
+        header >> boxes[i] >> owner[i];
+        for (int n = 0; n < nvars; ++n) {
+            header >> offset[i * nvars + n] >> nbytes[i * nvars + n];
+        }
+    }
+
+    mf.define(ba, dm, nvars, 0);
+
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const int i = mfi.index();
+        const Box& bx = mfi.validbox();
+
+        if (bx != boxes[i]) {
+            amrex::Error("read_compressed_level: BoxArray does not match " + level_dir);
+        }
+
+        const std::string data_name = amrex::Concatenate(level_dir + compressed_data_name, owner[i], 5);
+
+        std::ifstream data_file(data_name, std::ios::in | std::ios::binary);
+        if (!data_file.good()) {
+            amrex::FileOpenFailed(data_name);
+        }
+
+        FArrayBox host_fab(bx, nvars, The_Pinned_Arena());
+
+        for (int n = 0; n < nvars; ++n) {
+            Vector<char> buf(nbytes[i * nvars + n]);
+            data_file.seekg(offset[i * nvars + n], std::ios::beg);
+            data_file.read(buf.dataPtr(), buf.size());
+
+            plot_decompress_block(buf.dataPtr(), buf.size(), bx.numPts(), specs[n], host_fab.dataPtr(n));
+        }
+
+        mf[mfi].copy<RunOn::Device>(host_fab, bx, 0, bx, 0, nvars);
+        Gpu::streamSynchronize();
+    }
+}
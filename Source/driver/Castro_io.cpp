@@ -7,12 +7,16 @@
 #include <iostream>
 #include <string>
 #include <ctime>
+#include <future>
+#include <memory>
 
 #include <AMReX_Utility.H>
 #include <Castro.H>
 #include <Castro_F.H>
 #include <Castro_io.H>
+#include <Castro_compress.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_AsyncOut.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -59,6 +63,19 @@ namespace
 {
     int input_version = -1;
     int current_version = 9;
+
+    // Bookkeeping for the asynchronous output. The exposed time is
+    // what the simulation spends staging the data and waiting on the
+    // previous write; the hidden time is the rest of the time the I/O
+    // thread takes to drain an output to disk. The future is fulfilled
+    // by the marker task submitted after the last write of an output.
+
+    bool async_output_pending = false;
+    std::future<void> async_done_future;
+    double async_submit_time = 0.0;
+    double async_done_time = 0.0;
+    Real async_exposed_time = 0.0;
+    Real async_hidden_time = 0.0;
 }
 
 // I/O routines for Castro
@@ -401,12 +418,18 @@ Castro::checkPoint(const std::string& dir,
                    bool /*dump_old_default*/)
 {
 
+  if (level == 0) {
+      flush_async_output();
+  }
+
   const Real io_start_time = ParallelDescriptor::second();
 
   AmrLevel::checkPoint(dir, os, how, dump_old);
 
   const Real io_time = ParallelDescriptor::second() - io_start_time;
 
+  submit_async_output(io_time);
+
 #ifdef RADIATION
   if (do_radiation) {
     radiation->checkPoint(level, dir, os, how);
@@ -494,6 +517,78 @@ Castro::checkPoint(const std::string& dir,
 
 }
 
+void
+Castro::flush_async_output ()
+{
+    if (!amrex::AsyncOut::UseAsyncOut() || !async_output_pending) {
+        return;
+    }
+
+    BL_PROFILE("Castro::flush_async_output()");
+
+    const double wait_start = ParallelDescriptor::second();
+
+    // AsyncOut::Wait() only orders the ranks writing a file and
+    // AsyncOut::Finish() shuts the I/O thread down, so we instead wait
+    // for the marker task submitted after the output. The I/O thread
+    // runs its tasks in order, so everything before it is on disk, and
+    // async_done_time is up to date.
+
+    async_done_future.wait();
+
+    const double wait_time = ParallelDescriptor::second() - wait_start;
+
+    const Real drain_time = async_done_time - async_submit_time;
+    const Real hidden_time = amrex::max(0.0_rt, drain_time - static_cast<Real>(wait_time));
+
+    async_exposed_time += wait_time;
+    async_hidden_time += hidden_time;
+
+    async_output_pending = false;
+
+    if (verbose > 0) {
+        Real times[3] = {drain_time, static_cast<Real>(wait_time), hidden_time};
+        ParallelDescriptor::ReduceRealMax(times, 3, ParallelDescriptor::IOProcessorNumber());
+
+        amrex::Print() << "Asynchronous output: drained in " << times[0]
+                       << " s; " << times[1] << " s exposed waiting, "
+                       << times[2] << " s hidden (cumulative: "
+                       << async_exposed_time << " s exposed, "
+                       << async_hidden_time << " s hidden)" << std::endl;
+    }
+}
+
+
+
+void
+Castro::submit_async_output (Real stage_time)
+{
+    if (!amrex::AsyncOut::UseAsyncOut()) {
+        return;
+    }
+
+    // This is called once per level. The I/O thread works through its
+    // tasks in order, so the last marker runs once everything written
+    // for this output is on disk.
+
+    if (!async_output_pending) {
+        async_submit_time = ParallelDescriptor::second();
+        async_output_pending = true;
+    }
+
+    auto done = std::make_shared<std::promise<void>>();
+    async_done_future = done->get_future();
+
+    amrex::AsyncOut::Submit([done] () {
+        async_done_time = ParallelDescriptor::second();
+        done->set_value();
+    });
+
+    async_exposed_time += stage_time;
+}
+
+
+
 std::string
 Castro::thePlotFileType () const
 {
@@ -920,6 +1015,10 @@ Castro::plotFileOutput(const std::string& dir,
                        VisMF::How how,
                        const int is_small)
 {
+    if (level == 0) {
+        flush_async_output();
+    }
+
 #ifdef AMREX_PARTICLES
   ParticlePlotFile(dir);
 #endif
@@ -973,6 +1072,54 @@ Castro::plotFileOutput(const std::string& dir,
     if (Radiation::nplotvar > 0) n_data_items += Radiation::nplotvar;
 #endif
 
+    //
+    // Names of variables -- first state, then derived
+    //
+    Vector<std::string> plot_names;
+
+    for (int i =0; i < plot_var_map.size(); i++)
+    {
+        int typ = plot_var_map[i].first;
+        int comp = plot_var_map[i].second;
+        plot_names.push_back(desc_lst[typ].name(comp));
+    }
+
+    for (auto it = derive_names.begin(); it != derive_names.end(); ++it)
+    {
+        const DeriveRec* rec = derive_lst.get(*it);
+        if (rec->numDerive() > 1) {
+            for (int i = 0; i < rec->numDerive(); ++i) {
+                plot_names.push_back(rec->variableName(0) + '_' + std::to_string(i));
+            }
+        }
+        else {
+            plot_names.push_back(rec->variableName(0));
+        }
+    }
+
+#ifdef RADIATION
+    for (int i=0; i<Radiation::nplotvar; ++i) {
+        plot_names.push_back(Radiation::plotvar_names[i]);
+    }
+#endif
+
+    //
+    // Variables listed in castro.compress_vars are written separately
+    // (see Castro_compress.H); the Header and the Cell MultiFab only
+    // hold the uncompressed ones.
+    //
+    Vector<PlotCompressSpec> plot_specs;
+    get_plot_compress_specs(plot_names, plot_specs);
+
+    int n_compressed = 0;
+    for (const auto& spec : plot_specs) {
+        if (spec.mode != PlotUncompressed) {
+            n_compressed++;
+        }
+    }
+
+    const int n_uncompressed = n_data_items - n_compressed;
+
     Real cur_time = state[State_Type].curTime();
 
     if (level == 0 && ParallelDescriptor::IOProcessor())
@@ -986,36 +1133,17 @@ Castro::plotFileOutput(const std::string& dir,
           amrex::Error("Must specify at least one valid data item to plot");
         }
 
-        os << n_data_items << '\n';
-
-        //
-        // Names of variables -- first state, then derived
-        //
-        for (int i =0; i < plot_var_map.size(); i++)
-        {
-            int typ = plot_var_map[i].first;
-            int comp = plot_var_map[i].second;
-            os << desc_lst[typ].name(comp) << '\n';
+        if (n_uncompressed == 0) {
+          amrex::Error("At least one plotfile variable must not be in castro.compress_vars");
         }
 
-        for (auto it = derive_names.begin(); it != derive_names.end(); ++it)
-        {
-            const DeriveRec* rec = derive_lst.get(*it);
-            if (rec->numDerive() > 1) {
-                for (int i = 0; i < rec->numDerive(); ++i) {
-                    os << rec->variableName(0) + '_' + std::to_string(i) + '\n';
-                }
-            }
-            else {
-                os << rec->variableName(0) << '\n';
-            }
-        }
+        os << n_uncompressed << '\n';
 
-#ifdef RADIATION
-        for (int i=0; i<Radiation::nplotvar; ++i) {
-          os << Radiation::plotvar_names[i] << '\n';
+        for (int i = 0; i < plot_names.size(); i++) {
+            if (plot_specs[i].mode == PlotUncompressed) {
+                os << plot_names[i] << '\n';
+            }
         }
-#endif
 
         os << BL_SPACEDIM << '\n';
         os << parent->cumTime() << '\n';
@@ -1169,6 +1297,37 @@ Castro::plotFileOutput(const std::string& dir,
 
     const Real io_start_time = ParallelDescriptor::second();
 
+    if (n_compressed > 0) {
+
+        // Split off the compressed variables and write them directly
+        // into the level directory.
+
+        MultiFab compressMF(grids, dmap, n_compressed, nGrow);
+        MultiFab uncompressMF(grids, dmap, n_uncompressed, nGrow);
+
+        Vector<std::string> compress_names;
+        Vector<PlotCompressSpec> compress_specs;
+
+        int ic = 0;
+        int iu = 0;
+        for (int i = 0; i < plot_names.size(); i++) {
+            if (plot_specs[i].mode == PlotUncompressed) {
+                MultiFab::Copy(uncompressMF, plotMF, i, iu, 1, nGrow);
+                iu++;
+            } else {
+                MultiFab::Copy(compressMF, plotMF, i, ic, 1, nGrow);
+                compress_names.push_back(plot_names[i]);
+                compress_specs.push_back(plot_specs[i]);
+                ic++;
+            }
+        }
+
+        write_compressed_level(compressMF, compress_names, compress_specs, FullPath);
+
+        plotMF = std::move(uncompressMF);
+
+    }
+
     if (amrex::AsyncOut::UseAsyncOut()) {
         VisMF::AsyncWrite(std::move(plotMF),TheFullPath);
     } else {
@@ -1181,6 +1340,8 @@ Castro::plotFileOutput(const std::string& dir,
         writeJobInfo(dir, io_time);
     }
 
+    submit_async_output(io_time);
+
 #ifdef GRAVITY
     if (use_point_mass && level == 0) {
 
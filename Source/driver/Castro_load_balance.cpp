@@ -0,0 +1,177 @@
+#include <Castro.H>
+#include <runtime_parameters.H>
+
+#include <AMReX_ParallelDescriptor.H>
+
+using namespace amrex;
+
+void
+Castro::load_balance_box_costs (Vector<Real>& box_cost)
+{
+    BL_PROFILE("Castro::load_balance_box_costs()");
+
+    box_cost.resize(grids.size());
+
+    for (auto& c : box_cost) {
+        c = 0.0_rt;
+    }
+
+    const Real hydro_cost = load_balance_hydro_cost;
+
+    MultiFab& S_new = get_new_data(State_Type);
+
+#ifdef REACTIONS
+    MultiFab& R_new = get_new_data(Reactions_Type);
+    const int iweight = NumSpec + NumAux + 1;
+#endif
+
+    // We want the sum over each grid, so we do not tile here.
+
+    for (MFIter mfi(S_new); mfi.isValid(); ++mfi) {
+
+        const Box& bx = mfi.validbox();
+
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<Real> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef REACTIONS
+        auto weights = R_new.array(mfi);
+        const int do_burn_weights = do_react;
+#endif
+
+        reduce_op.eval(bx, reduce_data,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            Real cost = hydro_cost;
+
+#ifdef REACTIONS
+            // The burn weights are zero where we did not call the burner.
+
+            if (do_burn_weights == 1) {
+                cost += amrex::max(0.0_rt, weights(i,j,k,iweight));
+            }
+#endif
+
+            return {cost};
+        });
+
+        ReduceTuple hv = reduce_data.value();
+        box_cost[mfi.index()] = amrex::get<0>(hv);
+
+    }
+
+    ParallelDescriptor::ReduceRealSum(box_cost.dataPtr(), box_cost.size());
+}
+
+
+
+Real
+Castro::load_imbalance (const Vector<Real>& box_cost, const DistributionMapping& dm)
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    Vector<Real> rank_cost(nprocs, 0.0_rt);
+
+    for (int i = 0; i < static_cast<int>(box_cost.size()); ++i) {
+        rank_cost[dm[i]] += box_cost[i];
+    }
+
+    Real max_cost = 0.0_rt;
+    Real total_cost = 0.0_rt;
+
+    for (int n = 0; n < nprocs; ++n) {
+        max_cost = amrex::max(max_cost, rank_cost[n]);
+        total_cost += rank_cost[n];
+    }
+
+    if (total_cost <= 0.0_rt) {
+        return 1.0_rt;
+    }
+
+    return max_cost * static_cast<Real>(nprocs) / total_cost;
+}
+
+
+
+void
+Castro::load_balance (Amr* amr)
+{
+    BL_PROFILE("Castro::load_balance()");
+
+    if (ParallelDescriptor::NProcs() == 1) {
+        return;
+    }
+
+    const int finest_level = amr->finestLevel();
+
+    int lbase = finest_level + 1;
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+
+        Castro& castro_lev = dynamic_cast<Castro&>(amr->getLevel(lev));
+
+        Vector<Real> box_cost;
+        castro_lev.load_balance_box_costs(box_cost);
+
+        const Real old_imbalance = load_imbalance(box_cost, castro_lev.DistributionMap());
+
+        if (old_imbalance <= load_balance_threshold) {
+
+            if (verbose > 0) {
+                amrex::Print() << "... load imbalance on level " << lev << " is "
+                               << old_imbalance << "; not redistributing" << std::endl;
+            }
+
+            continue;
+
+        }
+
+        DistributionMapping new_dm;
+
+        if (load_balance_type == 1) {
+            new_dm = DistributionMapping::makeKnapSack(box_cost);
+        }
+        else {
+            new_dm = DistributionMapping::makeSFC(box_cost, castro_lev.boxArray());
+        }
+
+        const Real new_imbalance = load_imbalance(box_cost, new_dm);
+
+        if (verbose > 0) {
+            amrex::Print() << "... load imbalance on level " << lev << " is "
+                           << old_imbalance << "; new distribution has imbalance "
+                           << new_imbalance << std::endl;
+        }
+
+        // Only accept the new distribution if it actually helps.
+
+        if (new_imbalance >= old_imbalance) {
+            continue;
+        }
+
+        // This replaces the level with a new Castro object
+        // (initialized from the old one) using the new distribution.
+
+        amr->InstallNewDistributionMap(lev, new_dm);
+
+        lbase = amrex::min(lbase, lev);
+
+    }
+
+    // Redo the work we normally do after a regrid, e.g. rebuilding the
+    // masks and the gravitational field on the new distribution.
+
+    if (lbase <= finest_level) {
+
+        for (int lev = lbase; lev <= finest_level; ++lev) {
+            amr->getLevel(lev).post_regrid(lbase, finest_level);
+        }
+
+        // The post_regrid above will request another check at the end
+        // of the next coarse step; that is not needed here.
+
+        load_balance_pending = false;
+
+    }
+}
@@ -0,0 +1,178 @@
+#include <Castro.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace amrex;
+
+void
+Castro::compute_radial_average (const MultiFab& S, int scomp, int ncomp,
+                                const GpuArray<Real, 3>& center,
+                                Real dr, const Vector<Real>& r_edges, int nbins,
+                                bool radial_momentum,
+                                Vector<Real>& radial_state,
+                                Vector<Real>& radial_vol)
+{
+    BL_PROFILE("Castro::compute_radial_average()");
+
+    BL_ASSERT(S.boxArray() == grids);
+    BL_ASSERT(r_edges.empty() || static_cast<int>(r_edges.size()) == nbins + 1);
+
+    // Each bin holds the ncomp volume-weighted sums followed by the volume,
+    // so that the whole thing can be reduced in one go.
+
+    const int nbuf = nbins * (ncomp + 1);
+
+    // On the CPU each thread gets its own copy of the bins; on the GPU
+    // there is only one copy and we rely on atomics.
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    if (Gpu::notInLaunchRegion()) {
+        nthreads = omp_get_max_threads();
+    }
+#endif
+
+    Gpu::DeviceVector<Real> bins(nthreads * nbuf);
+    Real* const bins_ptr = bins.dataPtr();
+
+    amrex::ParallelFor(nthreads * nbuf,
+    [=] AMREX_GPU_HOST_DEVICE (int n)
+    {
+        bins_ptr[n] = 0.0_rt;
+    });
+
+    const bool uniform = r_edges.empty();
+
+    Gpu::DeviceVector<Real> edges(r_edges.size());
+    Gpu::copy(Gpu::hostToDevice, r_edges.begin(), r_edges.end(), edges.begin());
+    const Real* const edges_ptr = edges.dataPtr();
+
+    const Real drinv = uniform ? 1.0_rt / dr : 0.0_rt;
+
+    const auto dx = geom.CellSizeArray();
+    const auto problo = geom.ProbLoArray();
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    {
+        int tid = 0;
+#ifdef _OPENMP
+        if (Gpu::notInLaunchRegion()) {
+            tid = omp_get_thread_num();
+        }
+#endif
+
+        Real* const my_bins = bins_ptr + tid * nbuf;
+
+        for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+
+            auto u = S.const_array(mfi);
+            auto vol = volume.const_array(mfi);
+
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+                Real x = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - center[0];
+#if AMREX_SPACEDIM >= 2
+                Real y = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - center[1];
+#else
+                Real y = 0.0_rt;
+#endif
+#if AMREX_SPACEDIM == 3
+                Real z = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - center[2];
+#else
+                Real z = 0.0_rt;
+#endif
+
+                Real r = std::sqrt(x * x + y * y + z * z);
+
+                // Find the bin. Zones that fall outside of the bins are skipped.
+
+                int index;
+
+                if (uniform) {
+                    index = static_cast<int>(r * drinv);
+                    if (index >= nbins) {
+                        return;
+                    }
+                }
+                else {
+                    if (r < edges_ptr[0] || r >= edges_ptr[nbins]) {
+                        return;
+                    }
+
+                    int lo = 0;
+                    int hi = nbins;
+                    while (hi - lo > 1) {
+                        int mid = (lo + hi) / 2;
+                        if (r >= edges_ptr[mid]) {
+                            lo = mid;
+                        } else {
+                            hi = mid;
+                        }
+                    }
+                    index = lo;
+                }
+
+                Real radial_mom = 0.0_rt;
+                if (radial_momentum && r > 0.0_rt) {
+                    radial_mom = (u(i,j,k,UMX) * x + u(i,j,k,UMY) * y + u(i,j,k,UMZ) * z) / r;
+                }
+
+                Real* const b = my_bins + index * (ncomp + 1);
+
+                for (int n = 0; n < ncomp; ++n) {
+                    const int comp = scomp + n;
+
+                    Real val;
+                    if (radial_momentum && (comp == UMX || comp == UMY || comp == UMZ)) {
+                        val = radial_mom;
+                    } else {
+                        val = u(i,j,k,comp);
+                    }
+
+                    Gpu::Atomic::Add(&b[n], vol(i,j,k) * val);
+                }
+
+                Gpu::Atomic::Add(&b[ncomp], vol(i,j,k));
+            });
+        }
+    }
+
+    // Sum the thread-private copies and then do a single reduction over ranks.
+
+    Vector<Real> all_bins(nthreads * nbuf);
+    Gpu::copy(Gpu::deviceToHost, bins.begin(), bins.end(), all_bins.begin());
+
+    Vector<Real> sums(nbuf, 0.0_rt);
+
+    for (int it = 0; it < nthreads; ++it) {
+        for (int n = 0; n < nbuf; ++n) {
+            sums[n] += all_bins[it * nbuf + n];
+        }
+    }
+
+    ParallelDescriptor::ReduceRealSum(sums.dataPtr(), nbuf);
+
+    // Convert the sums into averages.
+
+    radial_state.resize(nbins * ncomp);
+    radial_vol.resize(nbins);
+
+    for (int i = 0; i < nbins; ++i) {
+        radial_vol[i] = sums[i * (ncomp + 1) + ncomp];
+
+        for (int n = 0; n < ncomp; ++n) {
+            if (radial_vol[i] > 0.0_rt) {
+                radial_state[i * ncomp + n] = sums[i * (ncomp + 1) + n] / radial_vol[i];
+            } else {
+                radial_state[i * ncomp + n] = 0.0_rt;
+            }
+        }
+    }
+}
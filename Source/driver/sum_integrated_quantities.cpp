@@ -8,6 +8,7 @@
 #endif
 
 #include <problem_diagnostics.H>
+#include <problem_integrated_sums.H>
 
 using namespace amrex;
 
@@ -48,98 +49,50 @@ Castro::sum_integrated_quantities ()
     int fixwidth     = 25; // Floating point data not in scientific notation
     int intwidth     = 12; // Integer data
 
+    // All of the integrals, including the species masses and the
+    // problem-defined integrals, are computed in a single pass over
+    // the state on each level.
+
+    Vector<Real> sums(num_integrated_quantities + NumSpec + num_problem_integrals, 0.0_rt);
+
     for (int lev = 0; lev <= finest_level; lev++)
     {
-        Castro& ca_lev = getLevel(lev);
+        getLevel(lev).add_integrated_sums(sums);
+    }
 
-        mass   += ca_lev.volWgtSum("density", time, local_flag);
-        mom[0] += ca_lev.volWgtSum("xmom", time, local_flag);
-        mom[1] += ca_lev.volWgtSum("ymom", time, local_flag);
-        mom[2] += ca_lev.volWgtSum("zmom", time, local_flag);
+    // Do a single parallel reduction for everything.
 
-        ang_mom[0] += ca_lev.volWgtSum("angular_momentum_x", time, local_flag);
-        ang_mom[1] += ca_lev.volWgtSum("angular_momentum_y", time, local_flag);
-        ang_mom[2] += ca_lev.volWgtSum("angular_momentum_z", time, local_flag);
+    amrex::ParallelDescriptor::ReduceRealSum(sums.dataPtr(), sums.size());
 
+    mass       = sums[int_mass];
+    mom[0]     = sums[int_xmom];
+    mom[1]     = sums[int_ymom];
+    mom[2]     = sums[int_zmom];
+    ang_mom[0] = sums[int_ang_mom_x];
+    ang_mom[1] = sums[int_ang_mom_y];
+    ang_mom[2] = sums[int_ang_mom_z];
 #ifdef HYBRID_MOMENTUM
-        hyb_mom[0] += ca_lev.volWgtSum("rmom", time, local_flag);
-        hyb_mom[1] += ca_lev.volWgtSum("lmom", time, local_flag);
-        hyb_mom[2] += ca_lev.volWgtSum("zmom", time, local_flag);
+    hyb_mom[0] = sums[int_hyb_mom_r];
+    hyb_mom[1] = sums[int_hyb_mom_l];
+    hyb_mom[2] = sums[int_zmom];
 #endif
-
-        if (show_center_of_mass) {
-           com[0] += ca_lev.locWgtSum("density", time, 0, local_flag);
-           com[1] += ca_lev.locWgtSum("density", time, 1, local_flag);
-           com[2] += ca_lev.locWgtSum("density", time, 2, local_flag);
-        }
-
-       rho_e += ca_lev.volWgtSum("rho_e", time, local_flag);
-       rho_K += ca_lev.volWgtSum("kineng", time, local_flag);
-       rho_E += ca_lev.volWgtSum("rho_E", time, local_flag);
+    com[0]     = sums[int_com_x];
+    com[1]     = sums[int_com_y];
+    com[2]     = sums[int_com_z];
+    rho_e      = sums[int_rho_e];
+    rho_K      = sums[int_rho_K];
+    rho_E      = sums[int_rho_E];
 #ifdef GRAVITY
-        if (gravity->get_gravity_type() == "PoissonGrav")
-               rho_phi += ca_lev.volProductSum("density", "phiGrav", time, local_flag);
+    rho_phi    = sums[int_rho_phi];
 #endif
 
-    }
+    problem_integrals.assign(sums.begin() + num_integrated_quantities + NumSpec, sums.end());
 
     if (verbose > 0)
     {
-
-#ifdef HYBRID_MOMENTUM
-#ifdef GRAVITY
-       const int nfoo = 14;
-#else
-       const int nfoo = 13;
-#endif
-#else
-#ifdef GRAVITY
-       const int nfoo = 11;
-#else
-       const int nfoo = 10;
-#endif
-#endif
-
-        Real foo[nfoo] = {mass, mom[0], mom[1], mom[2], ang_mom[0], ang_mom[1], ang_mom[2],
-#ifdef HYBRID_MOMENTUM
-                          hyb_mom[0], hyb_mom[1], hyb_mom[2],
-#endif
-#ifdef GRAVITY
-                          rho_e, rho_K, rho_E, rho_phi};
-#else
-                          rho_e, rho_K, rho_E};
-#endif
-
-#ifdef BL_LAZY
-        Lazy::QueueReduction( [=] () mutable {
-#endif
-
-        ParallelDescriptor::ReduceRealSum(foo, nfoo, ParallelDescriptor::IOProcessorNumber());
-
-        if (show_center_of_mass)
-            ParallelDescriptor::ReduceRealSum(com, 3, ParallelDescriptor::IOProcessorNumber());
-
         if (ParallelDescriptor::IOProcessor()) {
 
-            int i = 0;
-            mass       = foo[i++];
-            mom[0]     = foo[i++];
-            mom[1]     = foo[i++];
-            mom[2]     = foo[i++];
-            ang_mom[0] = foo[i++];
-            ang_mom[1] = foo[i++];
-            ang_mom[2] = foo[i++];
-#ifdef HYBRID_MOMENTUM
-            hyb_mom[0] = foo[i++];
-            hyb_mom[1] = foo[i++];
-            hyb_mom[2] = foo[i++];
-#endif
-            rho_e      = foo[i++];
-            rho_K      = foo[i++];
-            rho_E      = foo[i++];
 #ifdef GRAVITY
-            rho_phi    = foo[i++];
-
             // Total energy is -1/2 * rho * phi + rho * E for self-gravity,
             // and -rho * phi + rho * E for externally-supplied gravity.
             std::string gravity_type = gravity->get_gravity_type();
@@ -239,9 +192,6 @@ Castro::sum_integrated_quantities ()
                 std::cout << "TIME= " << time << " CENTER OF MASS Z-VEL = " << com_vel[2] << '\n';
             }
         }
-#ifdef BL_LAZY
-        });
-#endif
     }
 
 #ifdef GRAVITY
@@ -360,26 +310,10 @@ Castro::sum_integrated_quantities ()
             species_mass[i] = 0.0;
         }
 
-        // Integrated mass of all species on the domain
-
-        for (int lev = 0; lev <= finest_level; ++lev) {
-            for (int i = 0; i < NumSpec; ++i) {
-                species_mass[i] += getLevel(lev).volWgtSum("rho_" + species_names[i], time, local_flag) / C::M_solar;
-            }
-        }
-
-        int nfoo_sum = NumSpec;
-
-        amrex::Vector<Real> foo_sum(nfoo_sum);
-
-        for (int i = 0; i < NumSpec; ++i) {
-            foo_sum[i] = species_mass[i];
-        }
-
-        amrex::ParallelDescriptor::ReduceRealSum(foo_sum.dataPtr(), nfoo_sum);
+        // The integrated mass of all species on the domain was computed above.
 
         for (int i = 0; i < NumSpec; ++i) {
-            species_mass[i] = foo_sum[i];
+            species_mass[i] = sums[num_integrated_quantities + i] / C::M_solar;
         }
 
         if (ParallelDescriptor::IOProcessor()) {
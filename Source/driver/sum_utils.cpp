@@ -13,6 +13,9 @@
 #include <Rotation.H>
 #endif
 
+#include <prob_parameters.H>
+#include <problem_integrated_sums.H>
+
 using namespace amrex;
 
 Real
@@ -339,6 +342,251 @@ Castro::locSquaredSum (const std::string& name,
 
 
 
+void
+Castro::add_integrated_sums (Vector<Real>& sums)
+{
+    BL_PROFILE("Castro::add_integrated_sums()");
+
+    AMREX_ASSERT(sums.size() == num_integrated_quantities + NumSpec + num_problem_integrals);
+
+    const MultiFab& S_new = get_new_data(State_Type);
+
+#ifdef GRAVITY
+    const bool do_rho_phi = do_grav && gravity->get_gravity_type() == "PoissonGrav";
+    const MultiFab& phi_new = get_new_data(PhiGrav_Type);
+#endif
+
+    const bool use_mask = level < parent->finestLevel();
+
+    const MultiFab* mask = use_mask ? &getLevel(level+1).build_fine_mask() : nullptr;
+
+    auto dx     = geom.CellSizeArray();
+    auto problo = geom.ProbLoArray();
+
+    const GeometryData geomdata = geom.data();
+
+    // The scalar integrals are all done in one fused reduction.
+
+    ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+              ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+              ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+              ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_op;
+    ReduceData<Real, Real, Real, Real,
+               Real, Real, Real, Real,
+               Real, Real, Real, Real,
+               Real, Real, Real, Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    // The species masses and the problem-defined integrals are
+    // accumulated per thread (or on the device) alongside, since their
+    // number is only known at compile time through NumSpec and
+    // num_problem_integrals.
+
+    constexpr int nextra = NumSpec + num_problem_integrals;
+
+    Gpu::DeviceVector<Real> extra_sums(nextra, 0.0_rt);
+    Real* extra_ptr = extra_sums.dataPtr();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifndef AMREX_USE_GPU
+        Vector<Real> extra_priv(nextra, 0.0_rt);
+#endif
+
+        for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& box = mfi.tilebox();
+
+            auto U   = S_new.array(mfi);
+            auto vol = volume.array(mfi);
+
+            Array4<Real const> msk;
+            if (use_mask) {
+                msk = mask->array(mfi);
+            }
+
+#ifdef GRAVITY
+            auto phi = phi_new.array(mfi);
+#endif
+
+            reduce_op.eval(box, reduce_data,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+                Real dV = vol(i,j,k);
+
+                if (use_mask) {
+                    dV *= msk(i,j,k);
+                }
+
+                Real loc[3];
+
+                loc[0] = problo[0] + (0.5_rt + i) * dx[0];
+
+#if AMREX_SPACEDIM >= 2
+                loc[1] = problo[1] + (0.5_rt + j) * dx[1];
+#else
+                loc[1] = 0.0_rt;
+#endif
+
+#if AMREX_SPACEDIM == 3
+                loc[2] = problo[2] + (0.5_rt + k) * dx[2];
+#else
+                loc[2] = 0.0_rt;
+#endif
+
+                // The angular momentum is measured with respect to the center.
+
+                Real r[3] = {loc[0], loc[1], loc[2]};
+
+                for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                    r[dir] -= problem::center[dir];
+                }
+
+                const Real rho = U(i,j,k,URHO);
+                const Real mx  = U(i,j,k,UMX);
+                const Real my  = U(i,j,k,UMY);
+                const Real mz  = U(i,j,k,UMZ);
+
+                Real hyb_r = 0.0_rt;
+                Real hyb_l = 0.0_rt;
+#ifdef HYBRID_MOMENTUM
+                hyb_r = U(i,j,k,UMR);
+                hyb_l = U(i,j,k,UML);
+#endif
+
+                Real rho_phi = 0.0_rt;
+#ifdef GRAVITY
+                if (do_rho_phi) {
+                    rho_phi = rho * phi(i,j,k);
+                }
+#endif
+
+                const Real rho_K = 0.5_rt / rho * (mx * mx + my * my + mz * mz);
+
+                return {rho * dV,
+                        mx * dV,
+                        my * dV,
+                        mz * dV,
+                        (r[1] * mz - r[2] * my) * dV,
+                        (r[2] * mx - r[0] * mz) * dV,
+                        (r[0] * my - r[1] * mx) * dV,
+                        hyb_r * dV,
+                        hyb_l * dV,
+                        rho * loc[0] * dV,
+                        rho * loc[1] * dV,
+                        rho * loc[2] * dV,
+                        U(i,j,k,UEINT) * dV,
+                        rho_K * dV,
+                        U(i,j,k,UEDEN) * dV,
+                        rho_phi * dV};
+            });
+
+#ifdef AMREX_USE_GPU
+            // One atomic update per zone and species is acceptable on
+            // the GPU; this is not used on the CPU.
+
+            amrex::ParallelFor(box,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                Real dV = vol(i,j,k);
+
+                if (use_mask) {
+                    dV *= msk(i,j,k);
+                }
+
+                for (int n = 0; n < NumSpec; ++n) {
+                    Gpu::Atomic::Add(&extra_ptr[n], U(i,j,k,UFS+n) * dV);
+                }
+
+                if (num_problem_integrals > 0) {
+                    Real terms[amrex::max(num_problem_integrals, 1)] = {0.0_rt};
+                    problem_integrated_terms(i, j, k, U, geomdata, dV, terms);
+                    for (int n = 0; n < num_problem_integrals; ++n) {
+                        Gpu::Atomic::Add(&extra_ptr[NumSpec+n], terms[n]);
+                    }
+                }
+            });
+#else
+            const auto lo = amrex::lbound(box);
+            const auto hi = amrex::ubound(box);
+
+            for (int n = 0; n < NumSpec; ++n) {
+                Real sum = 0.0_rt;
+                for (int k = lo.z; k <= hi.z; ++k) {
+                    for (int j = lo.y; j <= hi.y; ++j) {
+                        for (int i = lo.x; i <= hi.x; ++i) {
+                            Real dV = vol(i,j,k);
+                            if (use_mask) {
+                                dV *= msk(i,j,k);
+                            }
+                            sum += U(i,j,k,UFS+n) * dV;
+                        }
+                    }
+                }
+                extra_priv[n] += sum;
+            }
+
+            if (num_problem_integrals > 0) {
+                for (int k = lo.z; k <= hi.z; ++k) {
+                    for (int j = lo.y; j <= hi.y; ++j) {
+                        for (int i = lo.x; i <= hi.x; ++i) {
+                            Real dV = vol(i,j,k);
+                            if (use_mask) {
+                                dV *= msk(i,j,k);
+                            }
+                            Real terms[amrex::max(num_problem_integrals, 1)] = {0.0_rt};
+                            problem_integrated_terms(i, j, k, U, geomdata, dV, terms);
+                            for (int n = 0; n < num_problem_integrals; ++n) {
+                                extra_priv[NumSpec+n] += terms[n];
+                            }
+                        }
+                    }
+                }
+            }
+#endif
+        }
+
+#ifndef AMREX_USE_GPU
+        for (int n = 0; n < nextra; ++n) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            extra_ptr[n] += extra_priv[n];
+        }
+#endif
+    }
+
+    ReduceTuple hv = reduce_data.value();
+
+    sums[int_mass]      += amrex::get<0>(hv);
+    sums[int_xmom]      += amrex::get<1>(hv);
+    sums[int_ymom]      += amrex::get<2>(hv);
+    sums[int_zmom]      += amrex::get<3>(hv);
+    sums[int_ang_mom_x] += amrex::get<4>(hv);
+    sums[int_ang_mom_y] += amrex::get<5>(hv);
+    sums[int_ang_mom_z] += amrex::get<6>(hv);
+    sums[int_hyb_mom_r] += amrex::get<7>(hv);
+    sums[int_hyb_mom_l] += amrex::get<8>(hv);
+    sums[int_com_x]     += amrex::get<9>(hv);
+    sums[int_com_y]     += amrex::get<10>(hv);
+    sums[int_com_z]     += amrex::get<11>(hv);
+    sums[int_rho_e]     += amrex::get<12>(hv);
+    sums[int_rho_K]     += amrex::get<13>(hv);
+    sums[int_rho_E]     += amrex::get<14>(hv);
+    sums[int_rho_phi]   += amrex::get<15>(hv);
+
+    Vector<Real> extra_host(nextra);
+    Gpu::copy(Gpu::deviceToHost, extra_sums.begin(), extra_sums.end(), extra_host.begin());
+
+    for (int n = 0; n < nextra; ++n) {
+        sums[num_integrated_quantities + n] += extra_host[n];
+    }
+}
+
+
+
 #ifdef GRAVITY
 void
 Castro::gwstrain (Real time,
@@ -357,34 +605,16 @@ Castro::gwstrain (Real time,
 
     GeometryData geomdata = geom.data();
 
-    auto mfrho   = derive("density",time,0);
-    auto mfxmom  = derive("xmom",time,0);
-    auto mfymom  = derive("ymom",time,0);
-    auto mfzmom  = derive("zmom",time,0);
-    auto mfgravx = derive("grav_x",time,0);
-    auto mfgravy = derive("grav_y",time,0);
-    auto mfgravz = derive("grav_z",time,0);
-
-    BL_ASSERT(mfrho   != nullptr);
-    BL_ASSERT(mfxmom  != nullptr);
-    BL_ASSERT(mfymom  != nullptr);
-    BL_ASSERT(mfzmom  != nullptr);
-    BL_ASSERT(mfgravx != nullptr);
-    BL_ASSERT(mfgravy != nullptr);
-    BL_ASSERT(mfgravz != nullptr);
+    // We read the state and gravitational field directly and apply the
+    // fine mask on the fly, so that the whole tensor is accumulated in
+    // a single pass over the level.
 
-    if (level < parent->finestLevel())
-    {
-	const MultiFab& mask = getLevel(level+1).build_fine_mask();
-
-	MultiFab::Multiply(*mfrho,   mask, 0, 0, 1, 0);
-	MultiFab::Multiply(*mfxmom,  mask, 0, 0, 1, 0);
-	MultiFab::Multiply(*mfymom,  mask, 0, 0, 1, 0);
-	MultiFab::Multiply(*mfzmom,  mask, 0, 0, 1, 0);
-	MultiFab::Multiply(*mfgravx, mask, 0, 0, 1, 0);
-	MultiFab::Multiply(*mfgravy, mask, 0, 0, 1, 0);
-	MultiFab::Multiply(*mfgravz, mask, 0, 0, 1, 0);
-    }
+    const MultiFab& S = get_data(State_Type, time);
+    const MultiFab& grav = get_data(Gravity_Type, time);
+
+    const bool use_mask = level < parent->finestLevel();
+
+    const MultiFab* mask = use_mask ? &getLevel(level+1).build_fine_mask() : nullptr;
 
     // Qtt stores the second time derivative of the quadrupole moment.
     // We calculate it directly rather than computing the quadrupole moment
@@ -392,187 +622,177 @@ Castro::gwstrain (Real time,
     // and requires the state at other timesteps. See, e.g., Equation 5 of
     // Loren-Aguilar et al. 2005.
 
-    // It is a 3x3 rank-2 tensor, but AMReX expects IntVect() to use BL_SPACEDIM
-    // dimensions, so we add a redundant third index in 3D.
-
-    Box bx( IntVect(D_DECL(0, 0, 0)), IntVect(D_DECL(2, 2, 0)) );
-
-    FArrayBox Qtt(bx);
+    // It is a symmetric 3x3 rank-2 tensor, so we only need to accumulate
+    // six components.
 
-    Qtt.setVal<RunOn::Device>(0.0);
+    ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum,
+              ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_op;
+    ReduceData<Real, Real, Real,
+               Real, Real, Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
 
 #ifdef _OPENMP
-    int nthreads = omp_get_max_threads();
-    Vector< std::unique_ptr<FArrayBox> > priv_Qtt(nthreads);
-    for (int i=0; i<nthreads; i++) {
-	priv_Qtt[i].reset(new FArrayBox(bx));
-    }
 #pragma omp parallel
 #endif
-    {
-#ifdef _OPENMP
-	int tid = omp_get_thread_num();
-	priv_Qtt[tid]->setVal<RunOn::Device>(0.0);
-#endif
-	for (MFIter mfi(*mfrho, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
-	    const Box& bx = mfi.tilebox();
+        const Box& bx = mfi.tilebox();
 
-            auto rho = (*mfrho).array(mfi);
-            auto vol = volume.array(mfi);
-            auto xmom = (*mfxmom).array(mfi);
-            auto ymom = (*mfymom).array(mfi);
-            auto zmom = (*mfzmom).array(mfi);
-            auto gravx = (*mfgravx).array(mfi);
-            auto gravy = (*mfgravy).array(mfi);
-            auto gravz = (*mfgravz).array(mfi);
-
-            // Calculate the second time derivative of the quadrupole moment tensor,
-            // according to the formula in Equation 6.5 of Blanchet, Damour and Schafer 1990.
-            // It involves integrating the mass distribution and then taking the symmetric
-            // trace-free part of the tensor. We can do the latter operation here since the
-            // integral is a linear operator and each part of the domain contributes independently.
+        auto U = S.array(mfi);
+        auto gravarr = grav.array(mfi);
+        auto vol = volume.array(mfi);
 
-#ifdef _OPENMP
-            auto Qtt_arr = priv_Qtt[tid]->array();
-#else
-            auto Qtt_arr = Qtt.array();
-#endif
+        Array4<Real const> msk;
+        if (use_mask) {
+            msk = mask->array(mfi);
+        }
 
-            amrex::ParallelFor(bx,
-            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-            {
-                Array2D<Real, 0, 2, 0, 2> dQtt{};
+        // Calculate the second time derivative of the quadrupole moment tensor,
+        // according to the formula in Equation 6.5 of Blanchet, Damour and Schafer 1990.
+        // It involves integrating the mass distribution and then taking the symmetric
+        // trace-free part of the tensor. We can do the latter operation here since the
+        // integral is a linear operator and each part of the domain contributes independently.
+
+        reduce_op.eval(bx, reduce_data,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            Array2D<Real, 0, 2, 0, 2> dQtt{};
 
-                GpuArray<Real, 3> r;
-                position(i, j, k, geomdata, r);
+            Real rho = U(i,j,k,URHO);
 
-                for (int n = 0; n < 3; ++n) {
-                    r[n] -= problem::center[n];
-                }
+            if (use_mask) {
+                rho *= msk(i,j,k);
+            }
 
-                Real rhoInv;
-                if (rho(i,j,k) > 0.0_rt) {
-                    rhoInv = 1.0_rt / rho(i,j,k);
-                } else {
-                    rhoInv = 0.0_rt;
-                }
+            GpuArray<Real, 3> r;
+            position(i, j, k, geomdata, r);
 
-                // Account for rotation, if there is any. These will leave
-                // r and vel and changed, if not.
+            for (int n = 0; n < 3; ++n) {
+                r[n] -= problem::center[n];
+            }
 
-                GpuArray<Real, 3> pos{r};
+            Real rhoInv;
+            if (U(i,j,k,URHO) > 0.0_rt) {
+                rhoInv = 1.0_rt / U(i,j,k,URHO);
+            } else {
+                rhoInv = 0.0_rt;
+            }
+
+            // Account for rotation, if there is any. These will leave
+            // r and vel and changed, if not.
+
+            GpuArray<Real, 3> pos{r};
 #ifdef ROTATION
-                pos = inertial_rotation(r, time);
+            pos = inertial_rotation(r, time);
 #endif
 
-                // For constructing the velocity in the inertial frame, we need to
-                // account for the fact that we have rotated the system already, so that
-                // the r in omega x r is actually the position in the inertial frame, and
-                // not the usual position in the rotating frame. It has to be on physical
-                // grounds, because for binary orbits where the stars aren't moving, that
-                // r never changes, and so the contribution from rotation would never change.
-                // But it must, since the motion vector of the stars changes in the inertial
-                // frame depending on where we are in the orbit.
-
-                GpuArray<Real, 3> vel;
-                vel[0] = xmom(i,j,k) * rhoInv;
-                vel[1] = ymom(i,j,k) * rhoInv;
-                vel[2] = zmom(i,j,k) * rhoInv;
-
-                GpuArray<Real, 3> inertial_vel{vel};
+            // For constructing the velocity in the inertial frame, we need to
+            // account for the fact that we have rotated the system already, so that
+            // the r in omega x r is actually the position in the inertial frame, and
+            // not the usual position in the rotating frame. It has to be on physical
+            // grounds, because for binary orbits where the stars aren't moving, that
+            // r never changes, and so the contribution from rotation would never change.
+            // But it must, since the motion vector of the stars changes in the inertial
+            // frame depending on where we are in the orbit.
+
+            GpuArray<Real, 3> vel;
+            vel[0] = U(i,j,k,UMX) * rhoInv;
+            vel[1] = U(i,j,k,UMY) * rhoInv;
+            vel[2] = U(i,j,k,UMZ) * rhoInv;
+
+            GpuArray<Real, 3> inertial_vel{vel};
 #ifdef ROTATION
-                rotational_to_inertial_velocity(i, j, k, geomdata, time, inertial_vel);
+            rotational_to_inertial_velocity(i, j, k, geomdata, time, inertial_vel);
 #endif
 
-                GpuArray<Real, 3> g;
-                g[0] = gravx(i,j,k);
-                g[1] = gravy(i,j,k);
-                g[2] = gravz(i,j,k);
+            GpuArray<Real, 3> g;
+            g[0] = gravarr(i,j,k,0);
+            g[1] = gravarr(i,j,k,1);
+            g[2] = gravarr(i,j,k,2);
 
-                // We need to rotate the gravitational field to be consistent with the rotated position.
+            // We need to rotate the gravitational field to be consistent with the rotated position.
 
-                GpuArray<Real, 3> inertial_g{g};
+            GpuArray<Real, 3> inertial_g{g};
 #ifdef ROTATION
-                inertial_g = inertial_rotation(g, time);
+            inertial_g = inertial_rotation(g, time);
 #endif
 
-                // Absorb the factor of 2 outside the integral into the zone mass, for efficiency.
+            // Absorb the factor of 2 outside the integral into the zone mass, for efficiency.
 
-                Real dM = 2.0_rt * rho(i,j,k) * vol(i,j,k);
+            Real dM = 2.0_rt * rho * vol(i,j,k);
 
-                if (AMREX_SPACEDIM == 3) {
+            if (AMREX_SPACEDIM == 3) {
 
-                    for (int m = 0; m < 3; ++m) {
-                        for (int l = 0; l < 3; ++l) {
-                            dQtt(l,m) += dM * (inertial_vel[l] * inertial_vel[m] + pos[l] * inertial_g[m]);
-                        }
+                for (int m = 0; m < 3; ++m) {
+                    for (int l = 0; l < 3; ++l) {
+                        dQtt(l,m) += dM * (inertial_vel[l] * inertial_vel[m] + pos[l] * inertial_g[m]);
                     }
+                }
 
-                } else {
-
-                    // For axisymmetric coordinates we need to be careful here.
-                    // We want to calculate the quadrupole tensor in terms of
-                    // Cartesian coordinates but our coordinates are cylindrical (R, z).
-                    // What we can do is to first express the Cartesian coordinates
-                    // as (x, y, z) = (R cos(phi), R sin(phi), z). Then we can integrate
-                    // out the phi coordinate for each component. The off-diagonal components
-                    // all then vanish automatically. The on-diagonal components xx and yy
-                    // pick up a factor of cos**2(phi) which when integrated from (0, 2*pi)
-                    // yields pi. Note that we're going to choose that the cylindrical z axis
-                    // coincides with the Cartesian x-axis, which is our default choice.
+            } else {
 
-                    // We also need to then divide by the volume by 2*pi since
-                    // it has already been integrated out.
+                // For axisymmetric coordinates we need to be careful here.
+                // We want to calculate the quadrupole tensor in terms of
+                // Cartesian coordinates but our coordinates are cylindrical (R, z).
+                // What we can do is to first express the Cartesian coordinates
+                // as (x, y, z) = (R cos(phi), R sin(phi), z). Then we can integrate
+                // out the phi coordinate for each component. The off-diagonal components
+                // all then vanish automatically. The on-diagonal components xx and yy
+                // pick up a factor of cos**2(phi) which when integrated from (0, 2*pi)
+                // yields pi. Note that we're going to choose that the cylindrical z axis
+                // coincides with the Cartesian x-axis, which is our default choice.
 
-                    dM /= (2.0_rt * M_PI);
+                // We also need to then divide by the volume by 2*pi since
+                // it has already been integrated out.
 
-                    dQtt(0,0) += dM * (2.0_rt * M_PI) * (inertial_vel[1] * inertial_vel[1] + pos[1] * inertial_g[1]);
-                    dQtt(1,1) += dM * M_PI * (inertial_vel[0] * inertial_vel[0] + pos[0] * g[0]);
-                    dQtt(2,2) += dM * M_PI * (inertial_vel[0] * inertial_vel[0] + pos[0] * g[0]);
+                dM /= (2.0_rt * M_PI);
 
-                }
+                dQtt(0,0) += dM * (2.0_rt * M_PI) * (inertial_vel[1] * inertial_vel[1] + pos[1] * inertial_g[1]);
+                dQtt(1,1) += dM * M_PI * (inertial_vel[0] * inertial_vel[0] + pos[0] * g[0]);
+                dQtt(2,2) += dM * M_PI * (inertial_vel[0] * inertial_vel[0] + pos[0] * g[0]);
 
-                // Now take the symmetric trace-free part of the quadrupole moment.
-                // The operator is defined in Equation 6.7 of Blanchet et al. (1990):
-                // STF(A^{ij}) = 1/2 A^{ij} + 1/2 A^{ji} - 1/3 delta^{ij} sum_{k} A^{kk}.
+            }
 
-                for (int l = 0; l < 3; ++l) {
-                    for (int m = 0; m < 3; ++m) {
+            // Now take the symmetric trace-free part of the quadrupole moment.
+            // The operator is defined in Equation 6.7 of Blanchet et al. (1990):
+            // STF(A^{ij}) = 1/2 A^{ij} + 1/2 A^{ji} - 1/3 delta^{ij} sum_{k} A^{kk}.
 
-                        Real dQ = 0.5_rt * dQtt(l,m) + 0.5_rt * dQtt(m,l);
-                        if (l == m) {
-                            dQ -= (1.0_rt / 3.0_rt) * dQtt(m,m);
-                        }
+            Real dQ[3][3];
 
-                        Gpu::Atomic::Add(&Qtt_arr(l,m,0), dQ);
+            for (int l = 0; l < 3; ++l) {
+                for (int m = 0; m < 3; ++m) {
 
+                    dQ[l][m] = 0.5_rt * dQtt(l,m) + 0.5_rt * dQtt(m,l);
+                    if (l == m) {
+                        dQ[l][m] -= (1.0_rt / 3.0_rt) * dQtt(m,m);
                     }
+
                 }
-            });
-        }
+            }
+
+            return {dQ[0][0], dQ[1][1], dQ[2][2],
+                    dQ[0][1], dQ[0][2], dQ[1][2]};
+        });
     }
 
-    // Do an OpenMP reduction on the tensor.
+    ReduceTuple hv = reduce_data.value();
 
-#ifdef _OPENMP
-    int n = bx.numPts();
-    Real* p = Qtt.dataPtr();
-#pragma omp barrier
-#pragma omp for nowait
-    for (int i=0; i<n; ++i)
-    {
-        for (int it=0; it<nthreads; it++) {
-            const Real* pq = priv_Qtt[it]->dataPtr();
-            p[i] += pq[i];
-        }
-    }
-#endif
+    Real Qtt[3][3];
+
+    Qtt[0][0] = amrex::get<0>(hv);
+    Qtt[1][1] = amrex::get<1>(hv);
+    Qtt[2][2] = amrex::get<2>(hv);
+    Qtt[0][1] = amrex::get<3>(hv);
+    Qtt[0][2] = amrex::get<4>(hv);
+    Qtt[1][2] = amrex::get<5>(hv);
+    Qtt[1][0] = Qtt[0][1];
+    Qtt[2][0] = Qtt[0][2];
+    Qtt[2][1] = Qtt[1][2];
 
     // Now, do a global reduce over all processes.
 
     if (!local) {
-        amrex::ParallelDescriptor::ReduceRealSum(Qtt.dataPtr(),bx.numPts());
+        amrex::ParallelDescriptor::ReduceRealSum(&Qtt[0][0], 9);
     }
 
     // Now that we have the second time derivative of the quadrupole
@@ -623,7 +843,7 @@ Castro::gwstrain (Real time,
             for (int k = 0; k < 3; ++k) {
                 for (int j = 0; j < 3; ++j) {
                     for (int i = 0; i < 3; ++i) {
-                        h[j][i] += proj[l][k][j][i] * Qtt.array()(k, l, 0);
+                        h[j][i] += proj[l][k][j][i] * Qtt[k][l];
                     }
                 }
             }
@@ -1,25 +1,11 @@
 #include <Castro.H>
 #include <Castro_F.H>
 
-#ifdef DIFFUSION
-#include <conductivity.H>
-#endif
-
 #ifdef MHD
 #include <mhd_util.H>
 #endif
 
-#ifdef ROTATION
-#include <Rotation.H>
-#endif
-
-#ifdef REACTIONS
-#ifdef NETWORK_HAS_CXX_IMPLEMENTATION
-#include <actual_rhs.H>
-#else
-#include <fortran_to_cxx_actual_rhs.H>
-#endif
-#endif
+#include <timestep.H>
 
 using namespace amrex;
 
@@ -29,9 +15,7 @@ Castro::estdt_cfl(const Real time)
 
   // Courant-condition limited timestep
 
-#ifdef ROTATION
   GeometryData geomdata = geom.data();
-#endif
 
   const auto dx = geom.CellSizeArray();
 
@@ -47,7 +31,7 @@ Castro::estdt_cfl(const Real time)
   for (MFIter mfi(stateMF, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
     const Box& box = mfi.tilebox();
 
-    auto u = stateMF.array(mfi);
+    auto u = stateMF.const_array(mfi);
 
     reduce_op.eval(box, reduce_data,
     [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
@@ -70,63 +54,7 @@ Castro::estdt_cfl(const Real time)
 
       eos(eos_input_re, eos_state);
 
-      // Compute velocity and then calculate CFL timestep.
-
-      Real ux = u(i,j,k,UMX) * rhoInv;
-      Real uy = u(i,j,k,UMY) * rhoInv;
-      Real uz = u(i,j,k,UMZ) * rhoInv;
-
-#ifdef ROTATION
-      if (castro::do_rotation == 1 && castro::state_in_rotating_frame != 1) {
-        GpuArray<Real, 3> vel;
-        vel[0] = ux;
-        vel[1] = uy;
-        vel[2] = uz;
-
-        inertial_to_rotational_velocity(i, j, k, geomdata, time, vel);
-
-        ux = vel[0];
-        uy = vel[1];
-        uz = vel[2];
-      }
-#endif
-
-      Real c = eos_state.cs;
-
-      Real dt1 = dx[0]/(c + std::abs(ux));
-
-      Real dt2;
-#if AMREX_SPACEDIM >= 2
-      dt2 = dx[1]/(c + std::abs(uy));
-#else
-      dt2 = dt1;
-#endif
-
-      Real dt3;
-#if AMREX_SPACEDIM == 3
-      dt3 = dx[2]/(c + std::abs(uz));
-#else
-      dt3 = dt1;
-#endif
-
-      // The CTU method has a less restrictive timestep than MOL-based
-      // schemes (including the true SDC).  Since the simplified SDC
-      // solver is based on CTU, we can use its timestep.
-      if (castro::time_integration_method == 0 || castro::time_integration_method == 3) {
-        return {amrex::min(dt1, dt2, dt3)};
-
-      } else {
-        // method of lines-style constraint is tougher
-        Real dt_tmp = 1.0_rt/dt1;
-#if AMREX_SPACEIM >= 2
-        dt_tmp += 1.0_rt/dt2;
-#endif
-#if AMREX_SPACEDIM == 3
-        dt_tmp += 1.0_rt/dt3;
-#endif
-
-        return 1.0_rt/dt_tmp;
-      }
+      return {cfl_zone_dt(i, j, k, u, eos_state.cs, dx, geomdata, time)};
 
     });
 
@@ -307,29 +235,7 @@ Castro::estdt_temp_diffusion(void)
 
                        eos(eos_input_re, eos_state);
 
-                       // we also need the conductivity
-                       conductivity(eos_state);
-
-                       // maybe we should check (and take action) on negative cv here?
-                       Real D = eos_state.conductivity * rho_inv / eos_state.cv;
-
-                       Real dt1 = 0.5_rt * dx[0]*dx[0] / D;
-
-                       Real dt2;
-#if AMREX_SPACEDIM >= 2
-                       dt2 = 0.5_rt * dx[1]*dx[1] / D;
-#else
-                       dt2 = dt1;
-#endif
-
-                       Real dt3;
-#if AMREX_SPACEDIM >= 3
-                       dt3 = 0.5_rt * dx[2]*dx[2] / D;
-#else
-                       dt3 = dt1;
-#endif
-
-                       return {amrex::min(dt1, dt2, dt3)};
+                       return {diffusion_zone_dt(eos_state, dx)};
 
                      } else {
                        return lmax_dt/lcfl;
@@ -368,13 +274,6 @@ Castro::estdt_burning()
         const auto S = S_new[mfi].array();
         const auto R = R_new[mfi].array();
 
-        const auto dx = geom.CellSizeArray();
-
-        // Set a floor on the minimum size of a derivative. This floor
-        // is small enough such that it will result in no timestep limiting.
-
-        const Real derivative_floor = 1.e-50_rt;
-
         // We want to limit the timestep so that it is not larger than
         // dtnuc_e * (e / (de/dt)).  If the timestep factor dtnuc is
         // equal to 1, this says that we don't want the
@@ -401,85 +300,7 @@ Castro::estdt_burning()
         reduce_op.eval(box, reduce_data,
         [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
         {
-            Real rhoInv = 1.0_rt / S(i,j,k,URHO);
-
-            burn_t state;
-
-            state.rho = S(i,j,k,URHO);
-            state.T   = S(i,j,k,UTEMP);
-            state.e   = S(i,j,k,UEINT) * rhoInv;
-            for (int n = 0; n < NumSpec; ++n) {
-                state.xn[n] = S(i,j,k,UFS+n) * rhoInv;
-            }
-#if NAUX_NET > 0
-            for (int n = 0; n < NumAux; ++n) {
-                state.aux[n] = S(i,j,k,UFX+n) * rhoInv;
-            }
-#endif
-
-            if (state.T < castro::react_T_min || state.T > castro::react_T_max ||
-                state.rho < castro::react_rho_min || state.rho > castro::react_rho_max) {
-                return {1.e200_rt};
-            }
-
-            Real e    = state.e;
-            Real T    = amrex::max(state.T, castro::small_temp);
-            Real X[NumSpec];
-            for (int n = 0; n < NumSpec; ++n) {
-                X[n] = amrex::max(state.xn[n], small_x);
-            }
-
-            eos(eos_input_rt, state);
-
-#ifdef STRANG
-            state.self_heat = true;
-#endif
-            Array1D<Real, 1, neqs> ydot;
-            actual_rhs(state, ydot);
-
-            Real dedt = ydot(net_ienuc);
-            Real dXdt[NumSpec];
-            for (int n = 0; n < NumSpec; ++n) {
-                dXdt[n] = ydot(n+1) * aion[n];
-            }
-
-            // Apply a floor to the derivatives. This ensures that we don't
-            // divide by zero; it also gives us a quick method to disable
-            // the timestep limiting, because the floor is small enough
-            // that the implied timestep will be very large, and thus
-            // ignored compared to other limiters.
-
-            dedt = amrex::max(std::abs(dedt), derivative_floor);
-
-            for (int n = 0; n < NumSpec; ++n) {
-                if (X[n] >= castro::dtnuc_X_threshold) {
-                    dXdt[n] = amrex::max(std::abs(dXdt[n]), derivative_floor);
-                } else {
-                    dXdt[n] = derivative_floor;
-                }
-            }
-
-            Real dt_tmp = 1.e200_rt;
-
-#ifdef NSE
-            // we need to use the eos_state interface here because for
-            // SDC, if we come in with a burn_t, it expects to
-            // evaluate the NSE criterion based on the conserved state.
-
-            eos_t eos_state;
-            burn_to_eos(state, eos_state);
-
-            if (!in_nse(eos_state)) {
-#endif
-                dt_tmp = dtnuc_e * e / dedt;
-#ifdef NSE
-            }
-#endif
-            for (int n = 0; n < NumSpec; ++n) {
-                dt_tmp = amrex::min(dt_tmp, dtnuc_X * (X[n] / dXdt[n]));
-            }
-
-            return {dt_tmp};
+            return {burning_zone_dt(i, j, k, S)};
         });
 
     }
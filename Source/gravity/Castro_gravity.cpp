@@ -144,6 +144,13 @@ Castro::construct_new_gravity(int amr_iteration, int amr_ncycle, Real time)
 
         MultiFab::Copy(phi_new, phi_old, 0, 0, 1, phi_new.nGrow());
 
+        // Optionally improve this guess with a linear extrapolation from
+        // the previous step.
+
+        gravity->extrapolate_phi_guess(level, phi_new, phi_old,
+                                       get_state_data(PhiGrav_Type).prevTime(),
+                                       get_state_data(PhiGrav_Type).curTime());
+
         // Subtract off the (composite - level) contribution for the purposes
         // of the level solve. We'll add it back later.
 
@@ -243,10 +250,6 @@ void Castro::construct_old_gravity_source(MultiFab& source, MultiFab& state_in,
 
     // Gravitational source term for the time-level n data.
 
-#ifdef HYBRID_MOMENTUM
-    GeometryData geomdata = geom.data();
-#endif
-
     AMREX_ALWAYS_ASSERT(castro::grav_source_type >= 1 && castro::grav_source_type <= 4);
 
 #ifdef _OPENMP
@@ -256,109 +259,165 @@ void Castro::construct_old_gravity_source(MultiFab& source, MultiFab& state_in,
     {
         const Box& bx = mfi.tilebox();
 
-        Array4<Real const> const uold = state_in.array(mfi);
-        Array4<Real const> const grav = grav_old.array(mfi);
-        Array4<Real> const source_arr = source.array(mfi);
+        gsrc(bx, state_in.array(mfi), grav_old.array(mfi), source.array(mfi), dt);
+    }
 
-        amrex::ParallelFor(bx,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-        {
-            // Temporary array for seeing what the new state would be if the update were applied here.
+    if (castro::verbose > 1)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
 
-            GpuArray<Real, NUM_STATE> snew;
-            for (int n = 0; n < NUM_STATE; ++n) {
-                snew[n] = 0.0_rt;
-            }
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
 
-            // Temporary array for holding the update to the state.
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << "Castro::construct_old_gravity_source() time = " << run_time << "\n" << "\n";
+#ifdef BL_LAZY
+        });
+#endif
+    }
 
-            GpuArray<Real, NSRC> src;
-            for (int n = 0; n < NSRC; ++n) {
-                src[n] = 0.0_rt;
-            }
+}
 
-            // Gravitational source options for how to add the work to (rho E):
-            // grav_source_type =
-            // 1: Original version ("does work")
-            // 2: Modification of type 1 that updates the momentum before constructing the energy corrector
-            // 3: Puts all gravitational work into KE, not (rho e)
-            // 4: Conservative energy formulation
+void
+Castro::gsrc(const Box& bx,
+             Array4<Real const> const& uold,
+             Array4<Real const> const& grav,
+             Array4<Real> const& source,
+             const Real dt)
+{
+#ifdef HYBRID_MOMENTUM
+    GeometryData geomdata = geom.data();
+#endif
 
-            Real rho    = uold(i,j,k,URHO);
-            Real rhoInv = 1.0_rt / rho;
+    amrex::ParallelFor(bx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+    {
+        // Temporary array for seeing what the new state would be if the update were applied here.
 
-            for (int n = 0; n < NUM_STATE; ++n) {
-                snew[n] = uold(i,j,k,n);
-            }
+        GpuArray<Real, NUM_STATE> snew;
+        for (int n = 0; n < NUM_STATE; ++n) {
+            snew[n] = 0.0_rt;
+        }
 
-            Real old_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoInv;
+        // Temporary array for holding the update to the state.
 
-            GpuArray<Real, 3> Sr;
-            for (int n = 0; n < 3; ++n) {
-                Sr[n] = rho * grav(i,j,k,n);
+        GpuArray<Real, NSRC> src;
+        for (int n = 0; n < NSRC; ++n) {
+            src[n] = 0.0_rt;
+        }
 
-                src[UMX+n] = Sr[n];
+        // Gravitational source options for how to add the work to (rho E):
+        // grav_source_type =
+        // 1: Original version ("does work")
+        // 2: Modification of type 1 that updates the momentum before constructing the energy corrector
+        // 3: Puts all gravitational work into KE, not (rho e)
+        // 4: Conservative energy formulation
 
-                snew[UMX+n] += dt * src[UMX+n];
-            }
+        Real rho    = uold(i,j,k,URHO);
+        Real rhoInv = 1.0_rt / rho;
+
+        for (int n = 0; n < NUM_STATE; ++n) {
+            snew[n] = uold(i,j,k,n);
+        }
+
+        Real old_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoInv;
+
+        GpuArray<Real, 3> Sr;
+        for (int n = 0; n < 3; ++n) {
+            Sr[n] = rho * grav(i,j,k,n);
+
+            src[UMX+n] = Sr[n];
+
+            snew[UMX+n] += dt * src[UMX+n];
+        }
 
 #ifdef HYBRID_MOMENTUM
-            GpuArray<Real, 3> loc;
-            for (int n = 0; n < 3; ++n) {
-                position(i, j, k, geomdata, loc);
-                loc[n] -= problem::center[n];
-            }
+        GpuArray<Real, 3> loc;
+        for (int n = 0; n < 3; ++n) {
+            position(i, j, k, geomdata, loc);
+            loc[n] -= problem::center[n];
+        }
 
-            GpuArray<Real, 3> hybrid_src;
+        GpuArray<Real, 3> hybrid_src;
 
-            set_hybrid_momentum_source(loc, Sr, hybrid_src);
+        set_hybrid_momentum_source(loc, Sr, hybrid_src);
 
-            for (int n = 0; n < 3; ++n) {
-                 src[UMR+n] = hybrid_src[n];
-                 snew[UMR+n] += dt * src[UMR+n];
-            }
+        for (int n = 0; n < 3; ++n) {
+             src[UMR+n] = hybrid_src[n];
+             snew[UMR+n] += dt * src[UMR+n];
+        }
 #endif
 
-            Real SrE;
+        Real SrE;
 
-            if (castro::grav_source_type == 1 || castro::grav_source_type == 2) {
+        if (castro::grav_source_type == 1 || castro::grav_source_type == 2) {
 
-                // Src = rho u dot g, evaluated with all quantities at t^n
+            // Src = rho u dot g, evaluated with all quantities at t^n
 
-                SrE = (uold(i,j,k,UMX) * Sr[0] + uold(i,j,k,UMY) * Sr[1] + uold(i,j,k,UMZ) * Sr[2]) * rhoInv;
+            SrE = (uold(i,j,k,UMX) * Sr[0] + uold(i,j,k,UMY) * Sr[1] + uold(i,j,k,UMZ) * Sr[2]) * rhoInv;
 
-            } else if (castro::grav_source_type == 3) {
+        } else if (castro::grav_source_type == 3) {
 
-                Real new_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoInv;
-                SrE = new_ke - old_ke;
+            Real new_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoInv;
+            SrE = new_ke - old_ke;
 
-            } else if (castro::grav_source_type == 4) {
+        } else if (castro::grav_source_type == 4) {
 
-                // The conservative energy formulation does not strictly require
-                // any energy source-term here, because it depends only on the
-                // fluid motions from the hydrodynamical fluxes which we will only
-                // have when we get to the 'corrector' step. Nevertheless we add a
-                // predictor energy source term in the way that the other methods
-                // do, for consistency. We will fully subtract this predictor value
-                // during the corrector step, so that the final result is correct.
-                // Here we use the same approach as grav_source_type == 2.
+            // The conservative energy formulation does not strictly require
+            // any energy source-term here, because it depends only on the
+            // fluid motions from the hydrodynamical fluxes which we will only
+            // have when we get to the 'corrector' step. Nevertheless we add a
+            // predictor energy source term in the way that the other methods
+            // do, for consistency. We will fully subtract this predictor value
+            // during the corrector step, so that the final result is correct.
+            // Here we use the same approach as grav_source_type == 2.
 
-                SrE = (uold(i,j,k,UMX) * Sr[0] + uold(i,j,k,UMY) * Sr[1] + uold(i,j,k,UMZ) * Sr[2]) * rhoInv;
+            SrE = (uold(i,j,k,UMX) * Sr[0] + uold(i,j,k,UMY) * Sr[1] + uold(i,j,k,UMZ) * Sr[2]) * rhoInv;
 
-            }
+        }
 
-            src[UEDEN] = SrE;
+        src[UEDEN] = SrE;
 
-            snew[UEDEN] += dt * SrE;
+        snew[UEDEN] += dt * SrE;
 
-            // Add to the outgoing source array.
+        // Add to the outgoing source array.
 
-            for (int n = 0; n < NSRC; ++n) {
-                source_arr(i,j,k,n) += src[n];
-            }
+        for (int n = 0; n < NSRC; ++n) {
+            source(i,j,k,n) += src[n];
+        }
 
-        });
+    });
+}
+
+void Castro::construct_new_gravity_source(MultiFab& source, MultiFab& state_old, MultiFab& state_new, Real time, Real dt)
+{
+    BL_PROFILE("Castro::construct_new_gravity_source()");
 
+    const Real strt_time = ParallelDescriptor::second();
+
+    MultiFab& grav_old = get_old_data(Gravity_Type);
+    MultiFab& grav_new = get_new_data(Gravity_Type);
+
+    if (!do_grav) return;
+
+    AMREX_ALWAYS_ASSERT(castro::grav_source_type >= 1 && castro::grav_source_type <= 4);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(state_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+        corrgsrc(bx,
+                 state_old.array(mfi), state_new.array(mfi),
+                 grav_old.array(mfi), grav_new.array(mfi),
+                 source.array(mfi),
+                 (*mass_fluxes[0]).array(mfi), (*mass_fluxes[1]).array(mfi), (*mass_fluxes[2]).array(mfi),
+                 dt, volume.array(mfi));
     }
 
     if (castro::verbose > 1)
@@ -372,25 +431,26 @@ void Castro::construct_old_gravity_source(MultiFab& source, MultiFab& state_in,
         ParallelDescriptor::ReduceRealMax(run_time,IOProc);
 
         if (ParallelDescriptor::IOProcessor())
-            std::cout << "Castro::construct_old_gravity_source() time = " << run_time << "\n" << "\n";
+            std::cout << "Castro::construct_new_gravity_source() time = " << run_time << "\n" << "\n";
 #ifdef BL_LAZY
         });
 #endif
     }
-
 }
 
-void Castro::construct_new_gravity_source(MultiFab& source, MultiFab& state_old, MultiFab& state_new, Real time, Real dt)
+void
+Castro::corrgsrc(const Box& bx,
+                 Array4<Real const> const& uold,
+                 Array4<Real const> const& unew,
+                 Array4<Real const> const& gold,
+                 Array4<Real const> const& gnew,
+                 Array4<Real> const& source,
+                 Array4<Real const> const& flux0,
+                 Array4<Real const> const& flux1,
+                 Array4<Real const> const& flux2,
+                 const Real dt,
+                 Array4<Real const> const& vol)
 {
-    BL_PROFILE("Castro::construct_new_gravity_source()");
-
-    const Real strt_time = ParallelDescriptor::second();
-
-    MultiFab& grav_old = get_old_data(Gravity_Type);
-    MultiFab& grav_new = get_new_data(Gravity_Type);
-
-    if (!do_grav) return;
-
     GpuArray<Real, 3> dx;
     for (int i = 0; i < AMREX_SPACEDIM; ++i) {
         dx[i] = geom.CellSizeArray()[i];
@@ -403,211 +463,172 @@ void Castro::construct_new_gravity_source(MultiFab& source, MultiFab& state_old,
     GeometryData geomdata = geom.data();
 #endif
 
-    AMREX_ALWAYS_ASSERT(castro::grav_source_type >= 1 && castro::grav_source_type <= 4);
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
+    amrex::ParallelFor(bx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
     {
-        for (MFIter mfi(state_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-        {
-            const Box& bx = mfi.tilebox();
-
-            Array4<Real const> const uold  = state_old.array(mfi);
-            Array4<Real const> const unew  = state_new.array(mfi);
-            Array4<Real const> const gold  = grav_old.array(mfi);
-            Array4<Real const> const gnew  = grav_new.array(mfi);
-            Array4<Real const> const vol   = volume.array(mfi);
-            Array4<Real const> const flux0 = (*mass_fluxes[0]).array(mfi);
-            Array4<Real const> const flux1 = (*mass_fluxes[1]).array(mfi);
-            Array4<Real const> const flux2 = (*mass_fluxes[2]).array(mfi);
-            Array4<Real> const source_arr  = source.array(mfi);
-
-            amrex::ParallelFor(bx,
-            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-            {
-                GpuArray<Real, NSRC> src{};
-
-                Real hdtInv = 0.5_rt / dt;
-
-                // Gravitational source options for how to add the work to (rho E):
-                // grav_source_type =
-                // 1: Original version ("does work")
-                // 2: Modification of type 1 that updates the U before constructing SrEcorr
-                // 3: Puts all gravitational work into KE, not (rho e)
-                // 4: Conservative gravity approach (discussed in first white dwarf merger paper).
-
-                Real rhoo    = uold(i,j,k,URHO);
-                Real rhooinv = 1.0_rt / uold(i,j,k,URHO);
-
-                Real rhon    = unew(i,j,k,URHO);
-                Real rhoninv = 1.0_rt / unew(i,j,k,URHO);
-
-                // Temporary array for seeing what the new state would be if the update were applied here.
-
-                GpuArray<Real, NUM_STATE> snew{};
-                for (int n = 0; n < NUM_STATE; ++n) {
-                    snew[n] = unew(i,j,k,n);
-                }
+        GpuArray<Real, NSRC> src{};
 
-                Real old_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoninv;
+        Real hdtInv = 0.5_rt / dt;
 
-                // Define old source terms
+        // Gravitational source options for how to add the work to (rho E):
+        // grav_source_type =
+        // 1: Original version ("does work")
+        // 2: Modification of type 1 that updates the U before constructing SrEcorr
+        // 3: Puts all gravitational work into KE, not (rho e)
+        // 4: Conservative gravity approach (discussed in first white dwarf merger paper).
 
-                GpuArray<Real, 3> vold;
-                for (int n = 0; n < 3; ++n) {
-                    vold[n] = uold(i,j,k,UMX+n) * rhooinv;
-                }
+        Real rhoo    = uold(i,j,k,URHO);
+        Real rhooinv = 1.0_rt / uold(i,j,k,URHO);
 
-                GpuArray<Real, 3> Sr_old;
-                for (int n = 0; n < 3; ++n) {
-                    Sr_old[n] = rhoo * gold(i,j,k,n);
-                }
+        Real rhon    = unew(i,j,k,URHO);
+        Real rhoninv = 1.0_rt / unew(i,j,k,URHO);
 
-                Real SrE_old = vold[0] * Sr_old[0] + vold[1] * Sr_old[1] + vold[2] * Sr_old[2];
+        // Temporary array for seeing what the new state would be if the update were applied here.
 
-                // Define new source terms
+        GpuArray<Real, NUM_STATE> snew{};
+        for (int n = 0; n < NUM_STATE; ++n) {
+            snew[n] = unew(i,j,k,n);
+        }
 
-                GpuArray<Real, 3> vnew;
-                for (int n = 0; n < 3; ++n) {
-                    vnew[n] = snew[UMX+n] * rhoninv;
-                }
+        Real old_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoninv;
 
-                GpuArray<Real, 3> Sr_new;
-                for (int n = 0; n < 3; ++n) {
-                    Sr_new[n] = rhon * gnew(i,j,k,n);
-                }
+        // Define old source terms
 
-                Real SrE_new = vnew[0] * Sr_new[0] + vnew[1] * Sr_new[1] + vnew[2] * Sr_new[2];
+        GpuArray<Real, 3> vold;
+        for (int n = 0; n < 3; ++n) {
+            vold[n] = uold(i,j,k,UMX+n) * rhooinv;
+        }
 
-                // Define corrections to source terms
+        GpuArray<Real, 3> Sr_old;
+        for (int n = 0; n < 3; ++n) {
+            Sr_old[n] = rhoo * gold(i,j,k,n);
+        }
 
-                GpuArray<Real, 3> Srcorr;
-                for (int n = 0; n < 3; ++n) {
-                    Srcorr[n] = 0.5_rt * (Sr_new[n] - Sr_old[n]);
-                }
+        Real SrE_old = vold[0] * Sr_old[0] + vold[1] * Sr_old[1] + vold[2] * Sr_old[2];
 
-                // Correct momenta
+        // Define new source terms
 
-                for (int n = 0; n < 3; ++n) {
-                    src[UMX+n] = Srcorr[n];
-                    snew[UMX+n] += dt * src[UMX+n];
-                }
+        GpuArray<Real, 3> vnew;
+        for (int n = 0; n < 3; ++n) {
+            vnew[n] = snew[UMX+n] * rhoninv;
+        }
 
-#ifdef HYBRID_MOMENTUM
-                GpuArray<Real, 3> loc;
-                position(i, j, k, geomdata, loc);
-                for (int n = 0; n < 3; ++n) {
-                    loc[n] -= problem::center[n];
-                }
+        GpuArray<Real, 3> Sr_new;
+        for (int n = 0; n < 3; ++n) {
+            Sr_new[n] = rhon * gnew(i,j,k,n);
+        }
 
-                GpuArray<Real, 3> hybrid_src;
+        Real SrE_new = vnew[0] * Sr_new[0] + vnew[1] * Sr_new[1] + vnew[2] * Sr_new[2];
 
-                set_hybrid_momentum_source(loc, Srcorr, hybrid_src);
+        // Define corrections to source terms
 
-                for (int n = 0; n < 3; ++n) {
-                    src[UMR+n] = hybrid_src[n];
-                    snew[UMR+n] += dt * src[UMR+n];
-                }
-#endif
+        GpuArray<Real, 3> Srcorr;
+        for (int n = 0; n < 3; ++n) {
+            Srcorr[n] = 0.5_rt * (Sr_new[n] - Sr_old[n]);
+        }
 
-                // Correct energy
+        // Correct momenta
 
-                Real SrEcorr;
+        for (int n = 0; n < 3; ++n) {
+            src[UMX+n] = Srcorr[n];
+            snew[UMX+n] += dt * src[UMX+n];
+        }
 
-                if (castro::grav_source_type == 1) {
+#ifdef HYBRID_MOMENTUM
+        GpuArray<Real, 3> loc;
+        position(i, j, k, geomdata, loc);
+        for (int n = 0; n < 3; ++n) {
+            loc[n] -= problem::center[n];
+        }
 
-                    // If grav_source_type == 1, then we calculated SrEcorr before updating the velocities.
+        GpuArray<Real, 3> hybrid_src;
 
-                    SrEcorr = 0.5_rt * (SrE_new - SrE_old);
+        set_hybrid_momentum_source(loc, Srcorr, hybrid_src);
 
-                } else if (castro::grav_source_type == 2) {
+        for (int n = 0; n < 3; ++n) {
+            src[UMR+n] = hybrid_src[n];
+            snew[UMR+n] += dt * src[UMR+n];
+        }
+#endif
 
-                    // For this source type, we first update the momenta
-                    // before we calculate the energy source term.
+        // Correct energy
 
-                    for (int n = 0; n < 3; ++n) {
-                        vnew[n] = snew[UMX+n] * rhoninv;
-                    }
-                    SrE_new = vnew[0] * Sr_new[0] + vnew[1] * Sr_new[1] + vnew[2] * Sr_new[2];
+        Real SrEcorr;
 
-                    SrEcorr = 0.5_rt * (SrE_new - SrE_old);
+        if (castro::grav_source_type == 1) {
 
-                } else if (castro::grav_source_type == 3) {
+            // If grav_source_type == 1, then we calculated SrEcorr before updating the velocities.
 
-                    // Instead of calculating the energy source term explicitly,
-                    // we simply update the kinetic energy.
+            SrEcorr = 0.5_rt * (SrE_new - SrE_old);
 
-                    Real new_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoninv;
-                    SrEcorr = new_ke - old_ke;
+        } else if (castro::grav_source_type == 2) {
 
-                } else if (castro::grav_source_type == 4) {
+            // For this source type, we first update the momenta
+            // before we calculate the energy source term.
 
-                    // First, subtract the predictor step we applied earlier.
+            for (int n = 0; n < 3; ++n) {
+                vnew[n] = snew[UMX+n] * rhoninv;
+            }
+            SrE_new = vnew[0] * Sr_new[0] + vnew[1] * Sr_new[1] + vnew[2] * Sr_new[2];
 
-                    SrEcorr = - SrE_old;
+            SrEcorr = 0.5_rt * (SrE_new - SrE_old);
 
-                    // For an explanation of this approach, see wdmerger paper I.
-                    // The main idea is that we are evaluating the change of the
-                    // potential energy at zone edges and applying that in an equal
-                    // and opposite sense to the gas energy. The physics is described
-                    // in Section 2.4; we are using a version of the formula similar to
-                    // Equation 94 in Springel (2010) based on the gradient rather than
-                    // the potential because the gradient-version works for all forms
-                    // of gravity we use, some of which do not explicitly calculate phi.
+        } else if (castro::grav_source_type == 3) {
 
-                    // Construct the time-averaged edge-centered gravity.
+            // Instead of calculating the energy source term explicitly,
+            // we simply update the kinetic energy.
 
-                    GpuArray<Real, 3> g;
-                    for (int n = 0; n < 3; ++n) {
-                        g[n] = 0.5_rt * (gnew(i,j,k,n) + gold(i,j,k,n));
-                    }
+            Real new_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoninv;
+            SrEcorr = new_ke - old_ke;
 
-                    Real gxl = 0.5_rt * (g[0] + 0.5_rt * (gnew(i-1*dg0,j,k,0) + gold(i-1*dg0,j,k,0)));
-                    Real gxr = 0.5_rt * (g[0] + 0.5_rt * (gnew(i+1*dg0,j,k,0) + gold(i+1*dg0,j,k,0)));
+        } else if (castro::grav_source_type == 4) {
 
-                    Real gyl = 0.5_rt * (g[1] + 0.5_rt * (gnew(i,j-1*dg1,k,1) + gold(i,j-1*dg1,k,1)));
-                    Real gyr = 0.5_rt * (g[1] + 0.5_rt * (gnew(i,j+1*dg1,k,1) + gold(i,j+1*dg1,k,1)));
+            // First, subtract the predictor step we applied earlier.
 
-                    Real gzl = 0.5_rt * (g[2] + 0.5_rt * (gnew(i,j,k-1*dg2,2) + gold(i,j,k-1*dg2,2)));
-                    Real gzr = 0.5_rt * (g[2] + 0.5_rt * (gnew(i,j,k+1*dg2,2) + gold(i,j,k+1*dg2,2)));
+            SrEcorr = - SrE_old;
 
-                    SrEcorr += hdtInv * (flux0(i      ,j,k) * gxl * dx[0] +
-                                         flux0(i+1*dg0,j,k) * gxr * dx[0] +
-                                         flux1(i,j      ,k) * gyl * dx[1] +
-                                         flux1(i,j+1*dg1,k) * gyr * dx[1] +
-                                         flux2(i,j,k      ) * gzl * dx[2] +
-                                         flux2(i,j,k+1*dg2) * gzr * dx[2]) / vol(i,j,k);
+            // For an explanation of this approach, see wdmerger paper I.
+            // The main idea is that we are evaluating the change of the
+            // potential energy at zone edges and applying that in an equal
+            // and opposite sense to the gas energy. The physics is described
+            // in Section 2.4; we are using a version of the formula similar to
+            // Equation 94 in Springel (2010) based on the gradient rather than
+            // the potential because the gradient-version works for all forms
+            // of gravity we use, some of which do not explicitly calculate phi.
 
-                }
+            // Construct the time-averaged edge-centered gravity.
+
+            GpuArray<Real, 3> g;
+            for (int n = 0; n < 3; ++n) {
+                g[n] = 0.5_rt * (gnew(i,j,k,n) + gold(i,j,k,n));
+            }
 
-                src[UEDEN] = SrEcorr;
+            Real gxl = 0.5_rt * (g[0] + 0.5_rt * (gnew(i-1*dg0,j,k,0) + gold(i-1*dg0,j,k,0)));
+            Real gxr = 0.5_rt * (g[0] + 0.5_rt * (gnew(i+1*dg0,j,k,0) + gold(i+1*dg0,j,k,0)));
 
-                snew[UEDEN] += dt * SrEcorr;
+            Real gyl = 0.5_rt * (g[1] + 0.5_rt * (gnew(i,j-1*dg1,k,1) + gold(i,j-1*dg1,k,1)));
+            Real gyr = 0.5_rt * (g[1] + 0.5_rt * (gnew(i,j+1*dg1,k,1) + gold(i,j+1*dg1,k,1)));
 
-                // Add to the outgoing source array.
+            Real gzl = 0.5_rt * (g[2] + 0.5_rt * (gnew(i,j,k-1*dg2,2) + gold(i,j,k-1*dg2,2)));
+            Real gzr = 0.5_rt * (g[2] + 0.5_rt * (gnew(i,j,k+1*dg2,2) + gold(i,j,k+1*dg2,2)));
+
+            SrEcorr += hdtInv * (flux0(i      ,j,k) * gxl * dx[0] +
+                                 flux0(i+1*dg0,j,k) * gxr * dx[0] +
+                                 flux1(i,j      ,k) * gyl * dx[1] +
+                                 flux1(i,j+1*dg1,k) * gyr * dx[1] +
+                                 flux2(i,j,k      ) * gzl * dx[2] +
+                                 flux2(i,j,k+1*dg2) * gzr * dx[2]) / vol(i,j,k);
 
-                for (int n = 0; n < NSRC; ++n) {
-                    source_arr(i,j,k,n) += src[n];
-                }
-            });
         }
-    }
 
-    if (castro::verbose > 1)
-    {
-        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
-        Real      run_time = ParallelDescriptor::second() - strt_time;
+        src[UEDEN] = SrEcorr;
 
-#ifdef BL_LAZY
-        Lazy::QueueReduction( [=] () mutable {
-#endif
-        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+        snew[UEDEN] += dt * SrEcorr;
 
-        if (ParallelDescriptor::IOProcessor())
-            std::cout << "Castro::construct_new_gravity_source() time = " << run_time << "\n" << "\n";
-#ifdef BL_LAZY
-        });
-#endif
-    }
+        // Add to the outgoing source array.
+
+        for (int n = 0; n < NSRC; ++n) {
+            source(i,j,k,n) += src[n];
+        }
+    });
 }
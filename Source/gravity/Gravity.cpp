@@ -90,6 +90,8 @@ Gravity::Gravity(Amr* Parent, int _finest_level, BCRec* _phys_bc, int _Density)
      radial_pres.resize(MAX_LEV);
 #endif
 
+     phi_history.resize(MAX_LEV);
+
      if (gravity::gravity_type == "PoissonGrav") make_mg_bc();
      if (gravity::gravity_type == "PoissonGrav") init_multipole_grav();
      max_rhs = 0.0;
@@ -310,6 +312,16 @@ Gravity::install_level (int                   level,
        for (int n=0; n<BL_SPACEDIM; ++n)
            grad_phi_curr[level][n].reset(new MultiFab(level_data->getEdgeBoxArray(n),dm,1,1));
 
+       // Any saved multipole moments, operators, and potentials were
+       // computed on the old grids.
+
+       multipole_cache.clear();
+
+       mlmg_cache.clear();
+
+       phi_history[level].older.reset();
+       phi_history[level].newer.reset();
+
     } else if (gravity::gravity_type == "MonopoleGrav") {
 
         if (!geom.isAllPeriodic())
@@ -560,15 +572,17 @@ Gravity::gravity_sync (int crse_level, int fine_level, const Vector<MultiFab*>&
          std::cout << " ... Making bc's for delta_phi at crse_level 0"  << std::endl;
 
 #if (BL_SPACEDIM == 3)
-      if ( gravity::direct_sum_bcs )
+      if ( gravity::direct_sum_bcs == 2 )
+          fill_direct_sum_tree_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+      else if ( gravity::direct_sum_bcs )
           fill_direct_sum_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
       else {
-          fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+          fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level],true);
       }
 #elif (BL_SPACEDIM == 2)
-      fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+      fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level],true);
 #else
-      fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+      fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level],true);
 #endif
 
     }
@@ -1466,7 +1480,11 @@ Gravity::interpolate_monopole_grav(int level, RealVector& radial_grav, MultiFab&
 
 void
 Gravity::compute_radial_mass(const Box& bx,
-                             Array4<Real const> const u,
+                             Array4<Real const> const u_old,
+                             Array4<Real const> const u_new,
+                             Real alpha,
+                             Array4<Real const> const mask,
+                             bool use_mask,
                              RealVector& radial_mass,
                              RealVector& radial_vol,
                              int n1d, int level)
@@ -1550,6 +1568,23 @@ Gravity::compute_radial_mass(const Box& bx,
 
         } else {
 
+            // Time-interpolate the density, only reading the time levels we need.
+            // u_old is an empty array when alpha == 1.
+
+            Real rho;
+
+            if (alpha == 1.0_rt) {
+                rho = u_new(i,j,k,URHO);
+            } else if (alpha == 0.0_rt) {
+                rho = u_old(i,j,k,URHO);
+            } else {
+                rho = (1.0_rt - alpha) * u_old(i,j,k,URHO) + alpha * u_new(i,j,k,URHO);
+            }
+
+            if (use_mask) {
+                rho *= mask(i,j,k);
+            }
+
             for (int kk = 0; kk <= dg2 * (gravity::drdxfac - 1); ++kk) {
                 Real zz   = lo_k + (static_cast<Real>(kk) + 0.5_rt) * dz_frac;
                 Real zzsq = zz * zz;
@@ -1584,7 +1619,7 @@ Gravity::compute_radial_mass(const Box& bx,
                         }
 
                         if (index <= n1d - 1) {
-                            Gpu::Atomic::Add(&radial_mass_ptr[index], vol_frac * u(i,j,k,URHO));
+                            Gpu::Atomic::Add(&radial_mass_ptr[index], vol_frac * rho);
                             Gpu::Atomic::Add(&radial_vol_ptr[index], vol_frac);
                         }
 
@@ -1762,7 +1797,8 @@ Gravity::init_multipole_grav()
 }
 
 void
-Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi)
+Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi,
+                            bool is_sync)
 {
     BL_PROFILE("Gravity::fill_multipole_BCs()");
 
@@ -1808,6 +1844,103 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
     qUC.setVal<RunOn::Device>(0.0);
     qUS.setVal<RunOn::Device>(0.0);
 
+    // If we are caching the moments, start from the moments we computed
+    // the last time we did this kind of solve, and only add the contribution
+    // from the change in the source since then. The moments are linear in the
+    // source, so this gives the same answer as starting from scratch, but zones
+    // where the source did not change (e.g. the ambient material, or a solve
+    // repeated at the same time) do not need to be revisited. The cache must be
+    // rebuilt if the grids or the center changed. Each update adds roundoff,
+    // so we also rebuild it every multipole_cache_rebuild_interval coarse steps.
+
+    const bool use_cache = gravity::multipole_cache == 1;
+
+    MultipoleCache* cache = nullptr;
+
+    if (use_cache) {
+
+        const int slot = 2 * fine_level + (is_sync ? 1 : 0);
+
+        if (static_cast<int>(multipole_cache.size()) <= slot) {
+            multipole_cache.resize(slot + 1);
+        }
+
+        bool valid = multipole_cache[slot] != nullptr;
+
+        if (valid) {
+            for (int n = 0; n < 3; ++n) {
+                valid = valid && multipole_cache[slot]->center[n] == problem::center[n];
+            }
+            valid = valid && multipole_cache[slot]->qL0.box() == boxq0;
+            valid = valid && multipole_cache[slot]->qLC.box() == boxqC;
+
+            const int interval = gravity::multipole_cache_rebuild_interval;
+            valid = valid && (interval <= 0 ||
+                              parent->levelSteps(0) - multipole_cache[slot]->build_step < interval);
+        }
+
+        if (valid) {
+            for (int lev = crse_level; lev <= fine_level; ++lev) {
+                const MultiFab& cached_source = *multipole_cache[slot]->source[lev - crse_level];
+                valid = valid && cached_source.boxArray() == Rhs[lev - crse_level]->boxArray();
+                valid = valid && cached_source.DistributionMap() == Rhs[lev - crse_level]->DistributionMap();
+            }
+        }
+
+        if (!valid) {
+
+            if (gravity::verbose > 1) {
+                amrex::Print() << " ... rebuilding the multipole moment cache" << std::endl;
+            }
+
+            multipole_cache[slot].reset(new MultipoleCache);
+
+            cache = multipole_cache[slot].get();
+
+            for (int n = 0; n < 3; ++n) {
+                cache->center[n] = problem::center[n];
+            }
+
+            cache->build_step = parent->levelSteps(0);
+
+            cache->source.resize(fine_level - crse_level + 1);
+
+            for (int lev = crse_level; lev <= fine_level; ++lev) {
+                cache->source[lev - crse_level].reset(new MultiFab(Rhs[lev - crse_level]->boxArray(),
+                                                                   Rhs[lev - crse_level]->DistributionMap(), 1, 0));
+                cache->source[lev - crse_level]->setVal(0.0);
+            }
+
+            cache->qL0.resize(boxq0);
+            cache->qLC.resize(boxqC);
+            cache->qLS.resize(boxqS);
+            cache->qU0.resize(boxq0);
+            cache->qUC.resize(boxqC);
+            cache->qUS.resize(boxqS);
+
+            cache->qL0.setVal<RunOn::Device>(0.0);
+            cache->qLC.setVal<RunOn::Device>(0.0);
+            cache->qLS.setVal<RunOn::Device>(0.0);
+            cache->qU0.setVal<RunOn::Device>(0.0);
+            cache->qUC.setVal<RunOn::Device>(0.0);
+            cache->qUS.setVal<RunOn::Device>(0.0);
+
+        }
+        else {
+
+            cache = multipole_cache[slot].get();
+
+            qL0.copy<RunOn::Device>(cache->qL0);
+            qLC.copy<RunOn::Device>(cache->qLC);
+            qLS.copy<RunOn::Device>(cache->qLS);
+            qU0.copy<RunOn::Device>(cache->qU0);
+            qUC.copy<RunOn::Device>(cache->qUC);
+            qUS.copy<RunOn::Device>(cache->qUS);
+
+        }
+
+    }
+
     // This section needs to be generalized for computing
     // full multipole gravity, not just BCs. At present this
     // does nothing.
@@ -1898,9 +2031,23 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
                 auto rho = source[mfi].array();
                 auto vol = (*volume[lev])[mfi].array();
 
+                // Without the cache, rho_old is never read.
+
+                auto rho_old = use_cache ? (*cache->source[lev - crse_level])[mfi].array() : rho;
+
                 amrex::ParallelFor(bx,
                 [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
                 {
+                    Real drho = rho(i,j,k);
+
+                    if (use_cache) {
+                        drho -= rho_old(i,j,k);
+
+                        if (drho == 0.0_rt) {
+                            return;
+                        }
+                    }
+
                     // If we're using this to construct boundary values, then only fill
                     // the outermost bin.
 
@@ -1952,7 +2099,7 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
 
                     // Now, compute the multipole moments.
 
-                    multipole_add(cosTheta, phiAngle, r, rho(i,j,k), vol(i,j,k) * rmax_cubed_inv,
+                    multipole_add(cosTheta, phiAngle, r, drho, vol(i,j,k) * rmax_cubed_inv,
                                   qL0_arr, qLC_arr, qLS_arr, qU0_arr, qUC_arr, qUS_arr,
                                   npts, nlo, index, true);
 
@@ -1962,7 +2109,7 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
                     if (multipole::doSymmetricAdd) {
 
                         multipole_symmetric_add(x, y, z, problo, probhi,
-                                                rho(i,j,k), vol(i,j,k) * rmax_cubed_inv,
+                                                drho, vol(i,j,k) * rmax_cubed_inv,
                                                 qL0_arr, qLC_arr, qLS_arr, qU0_arr, qUC_arr, qUS_arr,
                                                 npts, nlo, index);
 
@@ -2033,8 +2180,23 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
 
         } // end OpenMP parallel loop
 
+        if (use_cache) {
+            MultiFab::Copy(*cache->source[lev - crse_level], source, 0, 0, 1, 0);
+        }
+
     } // end loop over levels
 
+    // Save the moments on this rank for the next call.
+
+    if (use_cache) {
+        cache->qL0.copy<RunOn::Device>(qL0);
+        cache->qLC.copy<RunOn::Device>(qLC);
+        cache->qLS.copy<RunOn::Device>(qLS);
+        cache->qU0.copy<RunOn::Device>(qU0);
+        cache->qUC.copy<RunOn::Device>(qUC);
+        cache->qUS.copy<RunOn::Device>(qUS);
+    }
+
     // Now, do a global reduce over all processes.
 
     if (!ParallelDescriptor::UseGpuAwareMpi()) {
@@ -2280,7 +2442,7 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
     const int hiVectXZ[3] = {domhi[0]+1, 0         , domhi[2]+1};
 
     const int loVectYZ[3] = {0         , domlo[1]-1, domlo[2]-1};
-    const int hiVectYZ[3] = {0         , domhi[1]+1, domhi[1]+1};
+    const int hiVectYZ[3] = {0         , domhi[1]+1, domhi[2]+1};
 
     const int bc_lo[3] = {domlo[0]-1, domlo[1]-1, domlo[2]-1};
     const int bc_hi[3] = {domhi[0]+1, domhi[1]+1, domhi[2]+1};
@@ -2320,10 +2482,6 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
     Box boxXZ(smallEndXZ, bigEndXZ);
     Box boxYZ(smallEndYZ, bigEndYZ);
 
-    const long nPtsXY = boxXY.numPts();
-    const long nPtsXZ = boxXZ.numPts();
-    const long nPtsYZ = boxYZ.numPts();
-
     FArrayBox bcXYLo(boxXY);
     FArrayBox bcXYHi(boxXY);
     FArrayBox bcXZLo(boxXZ);
@@ -2338,17 +2496,22 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
     bcYZLo.setVal<RunOn::Device>(0.0);
     bcYZHi.setVal<RunOn::Device>(0.0);
 
-    // Loop through the grids and compute the individual contributions
-    // to the BCs. The BC constructor is coded to only add to the
-    // BCs, so it is safe to directly hand the arrays to them.
+    // Determine if we need to add contributions from any symmetric boundaries.
 
-    int physbc_lo[3];
-    int physbc_hi[3];
+    GpuArray<bool, 3> doSymmetricAddLo {false};
+    GpuArray<bool, 3> doSymmetricAddHi {false};
+    bool doSymmetricAdd {false};
 
-    for (int dir = 0; dir < 3; dir++)
-    {
-      physbc_lo[dir] = phys_bc->lo(dir);
-      physbc_lo[dir] = phys_bc->hi(dir);
+    for (int b = 0; b < 3; ++b) {
+        if (phys_bc->lo(b) == Symmetry) {
+            doSymmetricAddLo[b] = true;
+            doSymmetricAdd      = true;
+        }
+
+        if (phys_bc->hi(b) == Symmetry) {
+            doSymmetricAddHi[b] = true;
+            doSymmetricAdd      = true;
+        }
     }
 
     for (int lev = crse_level; lev <= fine_level; ++lev) {
@@ -2368,409 +2531,553 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
 
         const auto dx = parent->Geom(lev).CellSizeArray();
 
-#ifdef _OPENMP
-        int nthreads = omp_get_max_threads();
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXYLo(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXYHi(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXZLo(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXZHi(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcYZLo(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcYZHi(nthreads);
-        for (int i=0; i<nthreads; i++) {
-            priv_bcXYLo[i].reset(new FArrayBox(boxXY));
-            priv_bcXYHi[i].reset(new FArrayBox(boxXY));
-            priv_bcXZLo[i].reset(new FArrayBox(boxXZ));
-            priv_bcXZHi[i].reset(new FArrayBox(boxXZ));
-            priv_bcYZLo[i].reset(new FArrayBox(boxYZ));
-            priv_bcYZHi[i].reset(new FArrayBox(boxYZ));
-        }
-#pragma omp parallel
-#endif
+        // Loop through the grids and add the contribution of each one to
+        // every boundary point. The threads divide up the boundary points,
+        // so they all add directly into the same BC arrays.
+
+        for (MFIter mfi(source); mfi.isValid(); ++mfi)
         {
-#ifdef _OPENMP
-            int tid = omp_get_thread_num();
-            priv_bcXYLo[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcXYHi[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcXZLo[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcXZHi[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcYZLo[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcYZHi[tid]->setVal<RunOn::Gpu>(0.0);
-#endif
-            for (MFIter mfi(source, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            const Box& bx = mfi.validbox();
+
+            const auto lo = lbound(bx);
+            const auto hi = ubound(bx);
+
+            const auto rho = source.const_array(mfi);
+            const auto vol = volume[lev]->const_array(mfi);
+
+            direct_sum_add_faces(bc_lo, bc_hi, problo, probhi, bc_dx,
+                                 bcXYLo, bcXYHi, bcXZLo, bcXZHi, bcYZLo, bcYZHi,
+            [=] AMREX_GPU_HOST_DEVICE (const GpuArray<Real, 3>& locb) -> Real
             {
-                const Box bx = mfi.tilebox();
+                return direct_sum_box_potential(rho, vol, lo, hi, problo, probhi, dx, locb,
+                                                doSymmetricAdd, doSymmetricAddLo, doSymmetricAddHi);
+            });
+        }
 
-                const auto rho = source[mfi].array();
-                const auto vol = (*volume[lev])[mfi].array();
+        // The masked copy of the source is freed at the end of this level.
 
-                // Determine if we need to add contributions from any symmetric boundaries.
+        Gpu::streamSynchronize();
 
-                GpuArray<bool, 3> doSymmetricAddLo {false};
-                GpuArray<bool, 3> doSymmetricAddHi {false};
-                bool doSymmetricAdd {false};
+    } // end loop over levels
 
-                for (int b = 0; b < 3; ++b) {
-                    if (physbc_lo[b] == Symmetry) {
-                        doSymmetricAddLo[b] = true;
-                        doSymmetricAdd      = true;
-                    }
+    direct_sum_fill_phi(bcXYLo, bcXYHi, bcXZLo, bcXZHi, bcYZLo, bcYZHi, phi);
 
-                    if (physbc_hi[b] == Symmetry) {
-                        doSymmetricAddHi[b] = true;
-                        doSymmetricAdd      = true;
-                    }
-                }
+    if (gravity::verbose)
+    {
+        const int IOProc = ParallelDescriptor::IOProcessorNumber();
+        Real      end    = ParallelDescriptor::second() - strt;
 
-#ifdef _OPENMP
-                auto bcXYLo_arr = priv_bcXYLo[tid]->array();
-                auto bcXYHi_arr = priv_bcXYHi[tid]->array();
-                auto bcXZLo_arr = priv_bcXZLo[tid]->array();
-                auto bcXZHi_arr = priv_bcXZHi[tid]->array();
-                auto bcYZLo_arr = priv_bcYZLo[tid]->array();
-                auto bcYZHi_arr = priv_bcYZHi[tid]->array();
-#else
-                auto bcXYLo_arr = bcXYLo.array();
-                auto bcXYHi_arr = bcXYHi.array();
-                auto bcXZLo_arr = bcXZLo.array();
-                auto bcXZHi_arr = bcXZHi.array();
-                auto bcYZLo_arr = bcYZLo.array();
-                auto bcYZHi_arr = bcYZHi.array();
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
 #endif
+        ParallelDescriptor::ReduceRealMax(end,IOProc);
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << "Gravity::fill_direct_sum_BCs() time = " << end << std::endl << std::endl;
+#ifdef BL_LAZY
+        });
+#endif
+    }
 
-                amrex::ParallelFor(bx,
-                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-                {
-                    GpuArray<Real, 3> loc, locb;
-                    loc[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0];
+}
 
-#if AMREX_SPACEDIM >= 2
-                    loc[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1];
-#else
-                    loc[1] = 0.0_rt;
-#endif
+void
+Gravity::direct_sum_fill_phi(FArrayBox& bcXYLo, FArrayBox& bcXYHi,
+                             FArrayBox& bcXZLo, FArrayBox& bcXZHi,
+                             FArrayBox& bcYZLo, FArrayBox& bcYZHi,
+                             MultiFab& phi)
+{
+    const long nPtsXY = bcXYLo.box().numPts();
+    const long nPtsXZ = bcXZLo.box().numPts();
+    const long nPtsYZ = bcYZLo.box().numPts();
 
-#if AMREX_SPACEDIM == 3
-                    loc[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2];
-#else
-                    loc[2] = 0.0_rt;
+    // The boundary locations are one zone outside the coarse domain.
+
+    const Box& domain = parent->Geom(0).Domain();
+
+    const int bc_lo[3] = {domain.smallEnd(0)-1, domain.smallEnd(1)-1, domain.smallEnd(2)-1};
+    const int bc_hi[3] = {domain.bigEnd(0)+1, domain.bigEnd(1)+1, domain.bigEnd(2)+1};
+
+    // because the number of elments in mpi_reduce is int
+    BL_ASSERT(nPtsXY <= std::numeric_limits<int>::max());
+    BL_ASSERT(nPtsXZ <= std::numeric_limits<int>::max());
+    BL_ASSERT(nPtsYZ <= std::numeric_limits<int>::max());
+
+    ParallelDescriptor::ReduceRealSum(bcXYLo.dataPtr(), nPtsXY);
+    ParallelDescriptor::ReduceRealSum(bcXYHi.dataPtr(), nPtsXY);
+    ParallelDescriptor::ReduceRealSum(bcXZLo.dataPtr(), nPtsXZ);
+    ParallelDescriptor::ReduceRealSum(bcXZHi.dataPtr(), nPtsXZ);
+    ParallelDescriptor::ReduceRealSum(bcYZLo.dataPtr(), nPtsYZ);
+    ParallelDescriptor::ReduceRealSum(bcYZHi.dataPtr(), nPtsYZ);
+
+#ifdef _OPENMP
+#pragma omp parallel
 #endif
+    for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx= mfi.growntilebox();
 
-                    // Do xy interfaces first. Note that the boundary conditions
-                    // on phi are expected to live directly on the interface.
-                    // We also have to handle the domain corners correctly. We are
-                    // assuming that bc_lo = domlo - 1 and bc_hi = domhi + 1, where
-                    // domlo and domhi are the coarse domain extent.
+        auto p = phi[mfi].array();
 
-                    for (int m = bc_lo[1]; m <= bc_hi[1]; ++m) {
-                        if (m == bc_lo[1]) {
-                            locb[1] = problo[1];
-                        }
-                        else if (m == bc_hi[1]) {
-                            locb[1] = probhi[1];
-                        }
-                        else {
-                            locb[1] = problo[1] + (static_cast<Real>(m) + 0.5_rt) * bc_dx[1];
-                        }
-                        Real dy2 = (loc[1] - locb[1]) * (loc[1] - locb[1]);
+        auto bcXYLo_arr = bcXYLo.array();
+        auto bcXYHi_arr = bcXYHi.array();
+        auto bcXZLo_arr = bcXZLo.array();
+        auto bcXZHi_arr = bcXZHi.array();
+        auto bcYZLo_arr = bcYZLo.array();
+        auto bcYZHi_arr = bcYZHi.array();
 
-                        for (int l = bc_lo[0]; l <= bc_hi[0]; ++l) {
-                            if (l == bc_lo[0]) {
-                                locb[0] = problo[0];
-                            }
-                            else if (l == bc_hi[0]) {
-                                locb[0] = probhi[1];
-                            }
-                            else {
-                                locb[0] = problo[0] + (static_cast<Real>(l) + 0.5_rt) * bc_dx[0];
-                            }
-                            Real dx2 = (loc[0] - locb[0]) * (loc[0] - locb[0]);
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+        {
+            if (i == bc_lo[0]) {
+                p(i,j,k) = bcYZLo_arr(0,j,k);
+            }
 
-                            locb[2] = problo[2];
-                            Real dz2 = (loc[2] - locb[2]) * (loc[2] - locb[2]);
+            if (i == bc_hi[0]) {
+                p(i,j,k) = bcYZHi_arr(0,j,k);
+            }
 
-                            Real r = std::sqrt(dx2 + dy2 + dz2);
+            if (j == bc_lo[1]) {
+                p(i,j,k) = bcXZLo_arr(i,0,k);
+            }
 
-                            Real dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+            if (j == bc_hi[1]) {
+                p(i,j,k) = bcXZHi_arr(i,0,k);
+            }
 
-                            // Now, add any contributions from mass that is hidden behind
-                            // a symmetric boundary.
+            if (k == bc_lo[2]) {
+                p(i,j,k) = bcXYLo_arr(i,j,0);
+            }
 
-                            if (doSymmetricAdd) {
+            if (k == bc_hi[2]) {
+                p(i,j,k) = bcXYHi_arr(i,j,0);
+            }
+        });
+    }
+}
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+void
+Gravity::fill_direct_sum_tree_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi)
+{
+    BL_PROFILE("Gravity::fill_direct_sum_tree_BCs()");
 
-                            }
+    BL_ASSERT(crse_level==0);
 
-                            Gpu::Atomic::Add(&bcXYLo_arr(l,m,0), dbc);
+    const Real strt = ParallelDescriptor::second();
 
-                            locb[2] = probhi[2];
-                            dz2 = (loc[2] - locb[2]) * (loc[2] - locb[2]);
+    const Geometry& crse_geom = parent->Geom(crse_level);
 
-                            r = std::sqrt(dx2 + dy2 + dz2);
+    const int* domlo = crse_geom.Domain().loVect();
+    const int* domhi = crse_geom.Domain().hiVect();
 
-                            dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+    const int bc_lo[3] = {domlo[0]-1, domlo[1]-1, domlo[2]-1};
+    const int bc_hi[3] = {domhi[0]+1, domhi[1]+1, domhi[2]+1};
 
-                            if (doSymmetricAdd) {
+    const auto bc_dx  = crse_geom.CellSizeArray();
+    const auto problo = crse_geom.ProbLoArray();
+    const auto probhi = crse_geom.ProbHiArray();
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+    // Storage arrays for the BCs; these are the same as for the
+    // brute force sum.
 
-                            }
+    Box boxXY(IntVect(bc_lo[0], bc_lo[1], 0), IntVect(bc_hi[0], bc_hi[1], 0));
+    Box boxXZ(IntVect(bc_lo[0], 0, bc_lo[2]), IntVect(bc_hi[0], 0, bc_hi[2]));
+    Box boxYZ(IntVect(0, bc_lo[1], bc_lo[2]), IntVect(0, bc_hi[1], bc_hi[2]));
 
-                            Gpu::Atomic::Add(&bcXYHi_arr(l,m,0), dbc);
+    FArrayBox bcXYLo(boxXY);
+    FArrayBox bcXYHi(boxXY);
+    FArrayBox bcXZLo(boxXZ);
+    FArrayBox bcXZHi(boxXZ);
+    FArrayBox bcYZLo(boxYZ);
+    FArrayBox bcYZHi(boxYZ);
 
-                        }
+    bcXYLo.setVal<RunOn::Device>(0.0);
+    bcXYHi.setVal<RunOn::Device>(0.0);
+    bcXZLo.setVal<RunOn::Device>(0.0);
+    bcXZHi.setVal<RunOn::Device>(0.0);
+    bcYZLo.setVal<RunOn::Device>(0.0);
+    bcYZHi.setVal<RunOn::Device>(0.0);
 
-                    }
+    // The parts of the tree description that are the same for every level.
 
-                    // Now do xz interfaces.
+    DirectSumTree tree;
 
-                    for (int n = bc_lo[2]; n <= bc_hi[2]; ++n) {
-                        if (n == bc_lo[2]) {
-                            locb[2] = problo[2];
-                        }
-                        else if (n == bc_hi[2]) {
-                            locb[2] = probhi[2];
-                        }
-                        else {
-                            locb[2] = problo[2] + (static_cast<Real>(n) + 0.5_rt) * bc_dx[2];
-                        }
-                        Real dz2 = (loc[2] - locb[2]) * (loc[2] - locb[2]);
+    for (int d = 0; d < 3; ++d) {
+        tree.problo[d] = problo[d];
+    }
 
-                        for (int l = bc_lo[0]; l <= bc_hi[0]; ++l) {
-                            if (l == bc_lo[0]) {
-                                locb[0] = problo[0];
-                            }
-                            else if (l == bc_hi[0]) {
-                                locb[0] = probhi[0];
-                            }
-                            else {
-                                locb[0] = problo[0] + (static_cast<Real>(l) + 0.5_rt) * bc_dx[0];
-                            }
-                            Real dx2 = (loc[0] - locb[0]) * (loc[0] - locb[0]);
+    tree.theta = gravity::direct_sum_theta;
+    tree.order = gravity::direct_sum_order;
 
-                            locb[1] = problo[1];
-                            Real dy2 = (loc[1] - locb[1]) * (loc[1] - locb[1]);
+    // The mass itself, then its images across every combination of the
+    // symmetric lower boundaries, then the same for the upper boundaries.
+    // This is the same set of images as direct_sum_symmetric_add.
 
-                            Real r = std::sqrt(dx2 + dy2 + dz2);
+    tree.nimg = 1;
+    for (int d = 0; d < 3; ++d) {
+        tree.img_off[0][d] = 0.0_rt;
+        tree.img_sgn[0][d] = 1.0_rt;
+    }
 
-                            Real dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+    for (int side = 0; side < 2; ++side) {
+        for (int dirs = 1; dirs < 8; ++dirs) {
 
-                            if (doSymmetricAdd) {
+            bool symmetric = true;
+            for (int d = 0; d < 3; ++d) {
+                if ((dirs & (1 << d)) != 0) {
+                    const int bc = (side == 0) ? phys_bc->lo(d) : phys_bc->hi(d);
+                    if (bc != Symmetry) {
+                        symmetric = false;
+                    }
+                }
+            }
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+            if (!symmetric) {
+                continue;
+            }
 
-                            }
+            const int n = tree.nimg++;
 
-                            Gpu::Atomic::Add(&bcXZLo_arr(l,0,n), dbc);
+            for (int d = 0; d < 3; ++d) {
+                if ((dirs & (1 << d)) != 0) {
+                    tree.img_off[n][d] = 2.0_rt * ((side == 0) ? problo[d] : probhi[d]);
+                    tree.img_sgn[n][d] = -1.0_rt;
+                }
+                else {
+                    tree.img_off[n][d] = 0.0_rt;
+                    tree.img_sgn[n][d] = 1.0_rt;
+                }
+            }
 
-                            locb[1] = probhi[1];
-                            dy2 = (loc[1] - locb[1]) * (loc[1] - locb[1]);
+        }
+    }
 
-                            r = std::sqrt(dx2 + dy2 + dz2);
+    for (int lev = crse_level; lev <= fine_level; ++lev) {
 
-                            dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+        // Create a local copy of the RHS so that we can mask it, and
+        // turn it into the mass of each zone: this is level 0 of the tree.
 
-                            if (doSymmetricAdd) {
+        MultiFab source(Rhs[lev - crse_level]->boxArray(),
+                        Rhs[lev - crse_level]->DistributionMap(),
+                        1, 0);
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+        MultiFab::Copy(source, *Rhs[lev - crse_level], 0, 0, 1, 0);
 
-                            }
+        if (lev < fine_level) {
+            const MultiFab& mask = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)))->build_fine_mask();
+            MultiFab::Multiply(source, mask, 0, 0, 1, 0);
+        }
 
-                            Gpu::Atomic::Add(&bcXZHi_arr(l,0,n), dbc);
+        MultiFab::Multiply(source, *volume[lev], 0, 0, 1, 0);
 
-                        }
+        const auto dx = parent->Geom(lev).CellSizeArray();
+        const Box& domain = parent->Geom(lev).Domain();
 
-                    }
+        for (int d = 0; d < 3; ++d) {
+            tree.dx[d] = dx[d];
+            tree.domlo[d] = domain.smallEnd(d);
+            tree.domhi[d] = domain.bigEnd(d);
+        }
 
-                    // Finally, do yz interfaces.
+        const auto lev_lo = tree.domlo;
+        const auto lev_hi = tree.domhi;
 
-                    for (int n = bc_lo[2]; n <= bc_hi[2]; ++n) {
-                        if (n == bc_lo[2]) {
-                            locb[2] = problo[2];
-                        }
-                        else if (n == bc_hi[2]) {
-                            locb[2] = probhi[2];
-                        }
-                        else {
-                            locb[2] = problo[2] + (static_cast<Real>(n) + 0.5_rt) * bc_dx[2];
-                        }
-                        Real dz2 = (loc[2] - locb[2]) * (loc[2] - locb[2]);
+        // The boxes keep their own levels until each of them spans at most
+        // two nodes in every direction; above that the levels cover the
+        // whole domain, which at that point has about as many nodes as
+        // there are boxes. This uses every box of the level, so that a
+        // rank with few or no boxes does not make a fine domain-wide level.
 
-                        for (int m = bc_lo[1]; m <= bc_hi[1]; ++m) {
-                            if (m == bc_lo[1]) {
-                                locb[1] = problo[1];
-                            }
-                            else if (m == bc_hi[1]) {
-                                locb[1] = probhi[1];
-                            }
-                            else {
-                                locb[1] = problo[1] + (static_cast<Real>(m) + 0.5_rt) * bc_dx[1];
-                            }
-                            Real dy2 = (loc[1] - locb[1]) * (loc[1] - locb[1]);
+        const int nbox = source.local_size();
 
-                            locb[0] = problo[0];
-                            Real dx2 = (loc[0] - locb[0]) * (loc[0] - locb[0]);
+        const BoxArray& ba = source.boxArray();
 
-                            Real r = std::sqrt(dx2 + dy2 + dz2);
+        int max_len = 1;
+        for (int i = 0; i < ba.size(); ++i) {
+            max_len = std::max(max_len, ba[i].longside());
+        }
 
-                            Real dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+        int nboxlevs = 1;
+        while ((1 << nboxlevs) < max_len) {
+            ++nboxlevs;
+        }
 
-                            if (doSymmetricAdd) {
+        AMREX_ALWAYS_ASSERT(nboxlevs < direct_sum_tree_max_levels);
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+        tree.nboxlevs = nboxlevs;
 
-                            }
+        Vector<Vector<FArrayBox>> box_fab(nbox);
+        Vector<Array4<Real const>> box_node_h(nbox * nboxlevs);
 
-                            Gpu::Atomic::Add(&bcYZLo_arr(0,m,n), dbc);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(source); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            const int b = mfi.LocalIndex();
 
-                            locb[0] = probhi[0];
-                            dx2 = (loc[0] - locb[0]) * (loc[0] - locb[0]);
+            const GpuArray<int, 3> blo = {bx.smallEnd(0), bx.smallEnd(1), bx.smallEnd(2)};
+            const GpuArray<int, 3> bhi = {bx.bigEnd(0), bx.bigEnd(1), bx.bigEnd(2)};
 
-                            r = std::sqrt(dx2 + dy2 + dz2);
+            box_node_h[b * nboxlevs] = source.const_array(mfi);
 
-                            dbc = -C::Gconst * rho(i,j,k) * vol(i,j,k) / r;
+            box_fab[b].resize(nboxlevs);
 
-                            if (doSymmetricAdd) {
+            Box nbx = bx;
 
-                                dbc += direct_sum_symmetric_add(loc, locb, problo, probhi,
-                                                                rho(i,j,k), vol(i,j,k),
-                                                                doSymmetricAddLo, doSymmetricAddHi);
+            for (int l = 1; l < nboxlevs; ++l) {
 
-                            }
+                nbx.coarsen(2);
 
-                            Gpu::Atomic::Add(&bcYZHi_arr(0,m,n), dbc);
+                box_fab[b][l].resize(nbx, direct_sum_tree_ncomp);
 
-                        }
+                auto nc = box_fab[b][l].array();
+                const auto nf = box_node_h[b * nboxlevs + l - 1];
 
-                    }
+                amrex::ParallelFor(nbx,
+                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+                {
+                    Real q[direct_sum_tree_ncomp] = {0.0_rt};
 
+                    const GpuArray<int, 3> pidx = {i, j, k};
+                    direct_sum_tree_gather(nf, l-1, blo, bhi, l, pidx, blo, bhi, problo, dx, q);
+
+                    for (int n = 0; n < direct_sum_tree_ncomp; ++n) {
+                        nc(i,j,k,n) = q[n];
+                    }
                 });
 
+                box_node_h[b * nboxlevs + l] = box_fab[b][l].const_array();
+
             }
+        }
 
-#ifdef _OPENMP
-            Real* pXYLo = bcXYLo.dataPtr();
-            Real* pXYHi = bcXYHi.dataPtr();
-            Real* pXZLo = bcXZLo.dataPtr();
-            Real* pXZHi = bcXZHi.dataPtr();
-            Real* pYZLo = bcYZLo.dataPtr();
-            Real* pYZHi = bcYZHi.dataPtr();
-#pragma omp barrier
-#pragma omp for nowait
-            for (int i=0; i<nPtsXY; i++) {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pl = priv_bcXYLo[it]->dataPtr();
-                    const Real* ph = priv_bcXYHi[it]->dataPtr();
-                    pXYLo[i] += pl[i];
-                    pXYHi[i] += ph[i];
+        // The lowest domain-wide level, merging the boxes, and the list of
+        // boxes that overlap each of its nodes. This is a small amount of
+        // work, so the boxes are done one at a time.
+
+        Vector<FArrayBox> node(direct_sum_tree_max_levels);
+
+        Box nbx = amrex::coarsen(domain, 1 << nboxlevs);
+
+        node[nboxlevs].resize(nbx, direct_sum_tree_ncomp);
+        node[nboxlevs].setVal<RunOn::Device>(0.0);
+
+        const long nnodes = nbx.numPts();
+
+        Vector<int> bnd_off_h(nnodes + 1, 0);
+        Vector<int> bnd_box_h;
+
+        const auto nbx_lo = lbound(nbx);
+        const auto nbx_len = length(nbx);
+
+        for (int pass = 0; pass < 2; ++pass) {
+            for (MFIter mfi(source); mfi.isValid(); ++mfi) {
+                const Box& cbx = amrex::coarsen(mfi.validbox(), 1 << nboxlevs);
+                const auto clo = lbound(cbx);
+                const auto chi = ubound(cbx);
+                for (int k = clo.z; k <= chi.z; ++k) {
+                    for (int j = clo.y; j <= chi.y; ++j) {
+                        for (int i = clo.x; i <= chi.x; ++i) {
+                            const int n = (i - nbx_lo.x) + (j - nbx_lo.y) * nbx_len.x + (k - nbx_lo.z) * nbx_len.x * nbx_len.y;
+                            if (pass == 0) {
+                                ++bnd_off_h[n+1];
+                            }
+                            else {
+                                bnd_box_h[bnd_off_h[n]++] = mfi.LocalIndex();
+                            }
+                        }
+                    }
                 }
             }
-#pragma omp for nowait
-            for (int i=0; i<nPtsXZ; i++) {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pl = priv_bcXZLo[it]->dataPtr();
-                    const Real* ph = priv_bcXZHi[it]->dataPtr();
-                    pXZLo[i] += pl[i];
-                    pXZHi[i] += ph[i];
+
+            if (pass == 0) {
+                for (long n = 0; n < nnodes; ++n) {
+                    bnd_off_h[n+1] += bnd_off_h[n];
                 }
+                bnd_box_h.resize(bnd_off_h[nnodes]);
             }
-#pragma omp for nowait
-            for (int i=0; i<nPtsYZ; i++) {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pl = priv_bcYZLo[it]->dataPtr();
-                    const Real* ph = priv_bcYZHi[it]->dataPtr();
-                    pYZLo[i] += pl[i];
-                    pYZHi[i] += ph[i];
+            else {
+                // The fill advanced each offset to the start of the next node.
+                for (long n = nnodes; n > 0; --n) {
+                    bnd_off_h[n] = bnd_off_h[n-1];
                 }
+                bnd_off_h[0] = 0;
             }
-#endif
         }
 
-    } // end loop over levels
+        {
+            auto nc = node[nboxlevs].array();
 
-    // because the number of elments in mpi_reduce is int
-    BL_ASSERT(nPtsXY <= std::numeric_limits<int>::max());
-    BL_ASSERT(nPtsXZ <= std::numeric_limits<int>::max());
-    BL_ASSERT(nPtsYZ <= std::numeric_limits<int>::max());
+            for (MFIter mfi(source); mfi.isValid(); ++mfi) {
+                const Box& bx = mfi.validbox();
+                const int b = mfi.LocalIndex();
 
-    ParallelDescriptor::ReduceRealSum(bcXYLo.dataPtr(), nPtsXY);
-    ParallelDescriptor::ReduceRealSum(bcXYHi.dataPtr(), nPtsXY);
-    ParallelDescriptor::ReduceRealSum(bcXZLo.dataPtr(), nPtsXZ);
-    ParallelDescriptor::ReduceRealSum(bcXZHi.dataPtr(), nPtsXZ);
-    ParallelDescriptor::ReduceRealSum(bcYZLo.dataPtr(), nPtsYZ);
-    ParallelDescriptor::ReduceRealSum(bcYZHi.dataPtr(), nPtsYZ);
+                const GpuArray<int, 3> blo = {bx.smallEnd(0), bx.smallEnd(1), bx.smallEnd(2)};
+                const GpuArray<int, 3> bhi = {bx.bigEnd(0), bx.bigEnd(1), bx.bigEnd(2)};
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-    for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const Box& bx= mfi.growntilebox();
+                const auto nf = box_node_h[b * nboxlevs + nboxlevs - 1];
 
-        auto p = phi[mfi].array();
+                amrex::ParallelFor(amrex::coarsen(bx, 1 << nboxlevs),
+                [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+                {
+                    Real q[direct_sum_tree_ncomp] = {0.0_rt};
 
-        auto bcXYLo_arr = bcXYLo.array();
-        auto bcXYHi_arr = bcXYHi.array();
-        auto bcXZLo_arr = bcXZLo.array();
-        auto bcXZHi_arr = bcXZHi.array();
-        auto bcYZLo_arr = bcYZLo.array();
-        auto bcYZHi_arr = bcYZHi.array();
+                    const GpuArray<int, 3> pidx = {i, j, k};
+                    direct_sum_tree_gather(nf, nboxlevs-1, blo, bhi, nboxlevs, pidx, lev_lo, lev_hi, problo, dx, q);
 
-        amrex::ParallelFor(bx,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-        {
-            if (i == bc_lo[0]) {
-                p(i,j,k) = bcYZLo_arr(0,j,k);
+                    for (int n = 0; n < direct_sum_tree_ncomp; ++n) {
+                        Gpu::Atomic::Add(&nc(i,j,k,n), q[n]);
+                    }
+                });
             }
+        }
 
-            if (i == bc_hi[0]) {
-                p(i,j,k) = bcYZHi_arr(0,j,k);
-            }
+        tree.node[nboxlevs] = node[nboxlevs].const_array();
 
-            if (j == bc_lo[1]) {
-                p(i,j,k) = bcXZLo_arr(i,0,k);
-            }
+        // The rest of the domain-wide levels, up to a single root node.
 
-            if (j == bc_hi[1]) {
-                p(i,j,k) = bcXZHi_arr(i,0,k);
-            }
+        int nlevs = nboxlevs + 1;
 
-            if (k == bc_lo[2]) {
-                p(i,j,k) = bcXYLo_arr(i,j,0);
-            }
+        while (nbx.numPts() > 1) {
 
-            if (k == bc_hi[2]) {
-                p(i,j,k) = bcXYHi_arr(i,j,0);
-            }
+            AMREX_ALWAYS_ASSERT(nlevs < direct_sum_tree_max_levels);
+
+            nbx.coarsen(2);
+
+            node[nlevs].resize(nbx, direct_sum_tree_ncomp);
+
+            auto nc = node[nlevs].array();
+            const auto nf = node[nlevs-1].const_array();
+            const int l = nlevs;
+
+            amrex::ParallelFor(nbx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+                Real q[direct_sum_tree_ncomp] = {0.0_rt};
+
+                const GpuArray<int, 3> pidx = {i, j, k};
+                direct_sum_tree_gather(nf, l-1, lev_lo, lev_hi, l, pidx, lev_lo, lev_hi, problo, dx, q);
+
+                for (int n = 0; n < direct_sum_tree_ncomp; ++n) {
+                    nc(i,j,k,n) = q[n];
+                }
+            });
+
+            tree.node[nlevs] = node[nlevs].const_array();
+
+            ++nlevs;
+
+        }
+
+        tree.nlevs = nlevs;
+
+        Gpu::DeviceVector<Array4<Real const>> box_node(box_node_h.size());
+        Gpu::DeviceVector<int> bnd_off(bnd_off_h.size());
+        Gpu::DeviceVector<int> bnd_box(bnd_box_h.size());
+
+        Gpu::copy(Gpu::hostToDevice, box_node_h.begin(), box_node_h.end(), box_node.begin());
+        Gpu::copy(Gpu::hostToDevice, bnd_off_h.begin(), bnd_off_h.end(), bnd_off.begin());
+        Gpu::copy(Gpu::hostToDevice, bnd_box_h.begin(), bnd_box_h.end(), bnd_box.begin());
+
+        tree.box_node = box_node.dataPtr();
+        tree.bnd_off = bnd_off.dataPtr();
+        tree.bnd_box = bnd_box.dataPtr();
+
+        const DirectSumTree t = tree;
+
+        // Walk the tree once for every boundary point.
+
+        direct_sum_add_faces(bc_lo, bc_hi, problo, probhi, bc_dx,
+                             bcXYLo, bcXYHi, bcXZLo, bcXZHi, bcYZLo, bcYZHi,
+        [=] AMREX_GPU_HOST_DEVICE (const GpuArray<Real, 3>& locb) -> Real
+        {
+            return direct_sum_tree_potential(t, locb);
         });
-    }
+
+        // The tree is freed at the end of this level.
+
+        Gpu::streamSynchronize();
+
+    } // end loop over levels
+
+    direct_sum_fill_phi(bcXYLo, bcXYHi, bcXZLo, bcXZHi, bcYZLo, bcYZHi, phi);
+
+    Real tree_time = ParallelDescriptor::second() - strt;
 
     if (gravity::verbose)
     {
         const int IOProc = ParallelDescriptor::IOProcessorNumber();
-        Real      end    = ParallelDescriptor::second() - strt;
+        Real      end    = tree_time;
 
 #ifdef BL_LAZY
         Lazy::QueueReduction( [=] () mutable {
 #endif
         ParallelDescriptor::ReduceRealMax(end,IOProc);
         if (ParallelDescriptor::IOProcessor())
-            std::cout << "Gravity::fill_direct_sum_BCs() time = " << end << std::endl << std::endl;
+            std::cout << "Gravity::fill_direct_sum_tree_BCs() time = " << end << std::endl << std::endl;
 #ifdef BL_LAZY
         });
 #endif
     }
 
+    if (gravity::direct_sum_compare) {
+
+        // Redo the boundary conditions with the brute force sum and
+        // report the largest difference on the boundary, relative to
+        // the largest boundary value, along with the time for each.
+
+        MultiFab phi_ds(phi.boxArray(), phi.DistributionMap(), 1, phi.nGrow());
+        phi_ds.setVal(0.0);
+
+        const Real ds_strt = ParallelDescriptor::second();
+
+        fill_direct_sum_BCs(crse_level, fine_level, Rhs, phi_ds);
+
+        Real ds_time = ParallelDescriptor::second() - ds_strt;
+
+        ReduceOps<ReduceOpMax, ReduceOpMax> reduce_op;
+        ReduceData<Real, Real> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.growntilebox();
+
+            auto p    = phi[mfi].array();
+            auto p_ds = phi_ds[mfi].array();
+
+            reduce_op.eval(bx, reduce_data,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+                if (i == bc_lo[0] || i == bc_hi[0] ||
+                    j == bc_lo[1] || j == bc_hi[1] ||
+                    k == bc_lo[2] || k == bc_hi[2]) {
+                    return {std::abs(p(i,j,k) - p_ds(i,j,k)), std::abs(p_ds(i,j,k))};
+                }
+                else {
+                    return {0.0_rt, 0.0_rt};
+                }
+            });
+        }
+
+        ReduceTuple hv = reduce_data.value();
+
+        Real max_vals[4] = {amrex::get<0>(hv), amrex::get<1>(hv), tree_time, ds_time};
+
+        ParallelDescriptor::ReduceRealMax(max_vals, 4);
+
+        const Real rel_err = (max_vals[1] > 0.0_rt) ? max_vals[0] / max_vals[1] : max_vals[0];
+
+        amrex::Print() << "Gravity::fill_direct_sum_tree_BCs(): relative error = " << rel_err
+                       << ", tree time = " << max_vals[2]
+                       << ", direct sum time = " << max_vals[3] << std::endl;
+
+    }
+
 }
 #endif
 
@@ -2987,8 +3294,11 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
         const Real t_new = LevelData[lev]->get_state_data(State_Type).curTime();
         const Real eps   = (t_new - t_old) * 1.e-6;
 
-        // Create MultiFab with NUM_STATE components and no ghost cells
-        MultiFab S(grids[lev],dmap[lev],NUM_STATE,0);
+        // We don't make a copy of the state here; instead the binning
+        // reads the density directly from the old and new state,
+        // weighting the new state by alpha.
+
+        Real alpha = 1.0;
 
         if ( eps == 0.0 )
         {
@@ -2996,29 +3306,19 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
             // dt is smaller than roundoff compared to the current time,
             // in which case we're probably in trouble anyway,
             // but we will still handle it gracefully here.
-            S.copy(LevelData[lev]->get_new_data(State_Type),0,0,NUM_STATE);
+            alpha = 1.0;
         }
         else if ( std::abs(time-t_old) < eps)
         {
-            S.copy(LevelData[lev]->get_old_data(State_Type),0,0,NUM_STATE);
+            alpha = 0.0;
         }
         else if ( std::abs(time-t_new) < eps)
         {
-            S.copy(LevelData[lev]->get_new_data(State_Type),0,0,NUM_STATE);
+            alpha = 1.0;
         }
         else if (time > t_old && time < t_new)
         {
-            Real alpha   = (time - t_old)/(t_new - t_old);
-            Real omalpha = 1.0 - alpha;
-
-            S.copy(LevelData[lev]->get_old_data(State_Type),0,0,NUM_STATE);
-            S.mult(omalpha);
-
-            MultiFab S_new(grids[lev],dmap[lev],NUM_STATE,0);
-            S_new.copy(LevelData[lev]->get_new_data(State_Type),0,0,NUM_STATE);
-            S_new.mult(alpha);
-
-            S.plus(S_new,0,NUM_STATE,0);
+            alpha = (time - t_old)/(t_new - t_old);
         }
         else
         {
@@ -3027,13 +3327,44 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
             amrex::Abort("Problem in Gravity::make_radial_gravity");
         }
 
+        // The old state is only read when alpha < 1. Before the first
+        // time levels are swapped, it has not been allocated.
+
+        const bool use_old = (alpha != 1.0);
+
+        const MultiFab* S_old = use_old ? &(LevelData[lev]->get_old_data(State_Type)) : nullptr;
+        const MultiFab& S_new = LevelData[lev]->get_new_data(State_Type);
+
+        const MultiFab* mask = nullptr;
+
         if (lev < level)
         {
             Castro* fine_level = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)));
-            const MultiFab& mask = fine_level->build_fine_mask();
+            mask = &(fine_level->build_fine_mask());
+        }
+
+#ifdef GR_GRAV
+        // The pressure comes from the EOS, which needs the full state,
+        // so for GR we still need the time-interpolated, masked copy.
+
+        MultiFab S(grids[lev],dmap[lev],NUM_STATE,0);
+
+        if (alpha == 0.0) {
+            MultiFab::Copy(S, *S_old, 0, 0, NUM_STATE, 0);
+        }
+        else if (alpha == 1.0) {
+            MultiFab::Copy(S, S_new, 0, 0, NUM_STATE, 0);
+        }
+        else {
+            MultiFab::LinComb(S, 1.0 - alpha, *S_old, 0, alpha, S_new, 0, 0, NUM_STATE, 0);
+        }
+
+        if (mask != nullptr)
+        {
             for (int n = 0; n < NUM_STATE; ++n)
-                MultiFab::Multiply(S, mask, 0, n, 1, 0);
+                MultiFab::Multiply(S, *mask, 0, n, 1, 0);
         }
+#endif
 
         int n1d = radial_mass[lev].size();
 
@@ -3043,9 +3374,11 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
         for (int i = 0; i < n1d; i++) radial_vol[lev][i] = 0.;
         for (int i = 0; i < n1d; i++) radial_mass[lev][i] = 0.;
 
+#ifdef GR_GRAV
         const Geometry& geom = parent->Geom(lev);
         const Real* dx   = geom.CellSize();
         Real dr = dx[0] / static_cast<Real>(gravity::drdxfac);
+#endif
 
 #ifdef _OPENMP
         int nthreads = omp_get_max_threads();
@@ -3067,13 +3400,16 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
 #ifdef _OPENMP
             int tid = omp_get_thread_num();
 #endif
-            for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
                 const Box& bx = mfi.tilebox();
-                FArrayBox& fab = S[mfi];
 
                 compute_radial_mass(bx,
-                                    fab.array(),
+                                    use_old ? S_old->const_array(mfi) : Array4<Real const>{},
+                                    S_new.const_array(mfi),
+                                    alpha,
+                                    mask != nullptr ? mask->const_array(mfi) : Array4<Real const>{},
+                                    mask != nullptr,
 #ifdef _OPENMP
                                     priv_radial_mass[tid],
                                     priv_radial_vol[tid],
@@ -3086,7 +3422,7 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
 #ifdef GR_GRAV
                 ca_compute_avgpres(AMREX_ARLIM_ANYD(bx.loVect()), AMREX_ARLIM_ANYD(bx.hiVect()),
                                    dx, dr,
-                                   BL_TO_FORTRAN_ANYD(fab),
+                                   BL_TO_FORTRAN_ANYD(S[mfi]),
 #ifdef _OPENMP
                                    priv_radial_pres[tid].dataPtr(),
 #else
@@ -3110,12 +3446,47 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
             }
 #endif
         }
+    }
+
+    // Now do a single global reduce of the bins on all levels.
+
+#ifdef GR_GRAV
+    const int nbins = 3;
+#else
+    const int nbins = 2;
+#endif
+
+    int nreduce = 0;
+    for (int lev = 0; lev <= level; lev++) {
+        nreduce += nbins * radial_mass[lev].size();
+    }
+
+    Vector<Real> radial_sums(nreduce);
+
+    int offset = 0;
+    for (int lev = 0; lev <= level; lev++) {
+        int n1d = radial_mass[lev].size();
+        for (int i = 0; i < n1d; i++) {
+            radial_sums[offset++] = radial_mass[lev][i];
+            radial_sums[offset++] = radial_vol[lev][i];
+#ifdef GR_GRAV
+            radial_sums[offset++] = radial_pres[lev][i];
+#endif
+        }
+    }
+
+    ParallelDescriptor::ReduceRealSum(radial_sums.dataPtr(), nreduce);
 
-        ParallelDescriptor::ReduceRealSum(radial_mass[lev].dataPtr() ,n1d);
-        ParallelDescriptor::ReduceRealSum(radial_vol[lev].dataPtr()  ,n1d);
+    offset = 0;
+    for (int lev = 0; lev <= level; lev++) {
+        int n1d = radial_mass[lev].size();
+        for (int i = 0; i < n1d; i++) {
+            radial_mass[lev][i] = radial_sums[offset++];
+            radial_vol[lev][i] = radial_sums[offset++];
 #ifdef GR_GRAV
-        ParallelDescriptor::ReduceRealSum(radial_pres[lev].dataPtr()  ,n1d);
+            radial_pres[lev][i] = radial_sums[offset++];
 #endif
+        }
 
         if (do_diag > 0)
         {
@@ -3380,7 +3751,9 @@ Gravity::solve_phi_with_mlmg (int crse_level, int fine_level,
         }
 
 #if (BL_SPACEDIM == 3)
-        if ( gravity::direct_sum_bcs ) {
+        if ( gravity::direct_sum_bcs == 2 ) {
+            fill_direct_sum_tree_BCs(crse_level, fine_level, rhs, *phi[0]);
+        } else if ( gravity::direct_sum_bcs ) {
             fill_direct_sum_BCs(crse_level, fine_level, rhs, *phi[0]);
         } else {
             fill_multipole_BCs(crse_level, fine_level, rhs, *phi[0]);
@@ -3486,10 +3859,87 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
     info.setAgglomeration(gravity::mlmg_agglomeration);
     info.setConsolidation(gravity::mlmg_consolidation);
 
-    MLPoisson mlpoisson(gmv, bav, dmv, info);
+    // Without caching, the operator and solver only live for this solve.
+
+    std::unique_ptr<MLPoisson> local_linop;
+    std::unique_ptr<MLMG> local_mlmg;
+
+    MLPoisson* linop = nullptr;
+    MLMG* solver = nullptr;
+
+    if (gravity::mlmg_cache_operators == 1) {
+
+        // Building the operator sets up the coarsened hierarchy, the
+        // metric terms, and the communication patterns, so we keep it
+        // for the next solve over the same levels.  The cache is
+        // cleared in install_level, but we also check the grids here,
+        // since the levels covered by a (crse_level, fine_level) pair
+        // can change without that level being reinstalled.
+
+        const int slot = MAX_LEV * crse_level + fine_level;
+        const int step = parent->levelSteps(0);
+
+        if (static_cast<int>(mlmg_cache.size()) <= slot) {
+            mlmg_cache.resize(slot + 1);
+        }
+
+        // Free the operators for levels that no longer exist, and those
+        // not used in this or the previous coarse step, so that a
+        // change in the level structure does not leave them holding
+        // memory.
+
+        for (int s = 0; s < static_cast<int>(mlmg_cache.size()); ++s) {
+            if (mlmg_cache[s] != nullptr &&
+                (s % MAX_LEV > parent->finestLevel() || mlmg_cache[s]->step < step - 1)) {
+                mlmg_cache[s].reset();
+            }
+        }
+
+        bool valid = mlmg_cache[slot] != nullptr;
+
+        if (valid) {
+            for (int ilev = 0; ilev < nlevs; ++ilev) {
+                valid = valid &&
+                    mlmg_cache[slot]->ba[ilev] == bav[ilev] &&
+                    mlmg_cache[slot]->dm[ilev] == dmv[ilev];
+            }
+        }
+
+        if (!valid) {
+
+            mlmg_cache[slot].reset(new MLMGCache);
+
+            mlmg_cache[slot]->ba = bav;
+            mlmg_cache[slot]->dm = dmv;
+
+            mlmg_cache[slot]->linop.reset(new MLPoisson(gmv, bav, dmv, info));
+            mlmg_cache[slot]->linop->setDomainBC(mlmg_lobc, mlmg_hibc);
+
+            mlmg_cache[slot]->mlmg.reset(new MLMG(*mlmg_cache[slot]->linop));
+
+        }
+
+        mlmg_cache[slot]->step = step;
+
+        linop = mlmg_cache[slot]->linop.get();
+        solver = mlmg_cache[slot]->mlmg.get();
+
+    } else {
+
+        local_linop.reset(new MLPoisson(gmv, bav, dmv, info));
+        local_linop->setDomainBC(mlmg_lobc, mlmg_hibc);
+
+        local_mlmg.reset(new MLMG(*local_linop));
+
+        linop = local_linop.get();
+        solver = local_mlmg.get();
+
+    }
+
+    MLPoisson& mlpoisson = *linop;
+    MLMG& mlmg = *solver;
 
     // BC
-    mlpoisson.setDomainBC(mlmg_lobc, mlmg_hibc);
     if (mlpoisson.needsCoarseDataForBC())
     {
         mlpoisson.setCoarseFineBC(crse_bcdata, parent->refRatio(crse_level-1)[0]);
@@ -3500,7 +3950,6 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
         mlpoisson.setLevelBC(ilev, phi[ilev]);
     }
 
-    MLMG mlmg(mlpoisson);
     mlmg.setVerbose(gravity::verbose - 1); // With normal verbosity we don't want MLMG information
     if (crse_level == 0) {
         mlmg.setMaxFmgIter(gravity::mlmg_max_fmg_iter);
@@ -3518,6 +3967,11 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
         mlmg.setNSolve(gravity::mlmg_nsolve);
         final_resnorm = mlmg.solve(phi, rhs, rel_eps, abs_eps);
 
+        if (gravity::verbose > 1) {
+            amrex::Print() << " ... MLMG solve for levels " << crse_level << " to " << fine_level
+                           << " took " << mlmg.getNumIters() << " iterations" << std::endl;
+        }
+
         mlmg.getGradSolution(grad_phi);
     }
     else if (!res.empty())
@@ -3527,3 +3981,52 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
 
     return final_resnorm;
 }
+
+void
+Gravity::extrapolate_phi_guess (int level, MultiFab& phi_new, const MultiFab& phi_old,
+                                Real t_old, Real t_new)
+{
+    if (gravity::mlmg_warm_start != 1) {
+        return;
+    }
+
+    BL_PROFILE("Gravity::extrapolate_phi_guess()");
+
+    PhiHistory& hist = phi_history[level];
+
+    // The old-time phi does not change during a step, but we may be
+    // called more than once per step (e.g. for a retry or an SDC
+    // iteration), so we only record it the first time we see it.
+
+    if (hist.newer == nullptr || hist.t_newer != t_old) {
+
+        std::swap(hist.older, hist.newer);
+        hist.t_older = hist.t_newer;
+
+        if (hist.newer == nullptr) {
+            hist.newer.reset(new MultiFab(phi_old.boxArray(), phi_old.DistributionMap(), 1, 0));
+        }
+
+        MultiFab::Copy(*hist.newer, phi_old, 0, 0, 1, 0);
+        hist.t_newer = t_old;
+
+    }
+
+    if (hist.older == nullptr || hist.t_older >= t_old) {
+        return;
+    }
+
+    // phi_new = phi_old + (t_new - t_old) / (t_old - t_older) * (phi_old - phi_older)
+    // on the valid region; the ghost cells are left as they are, since
+    // they hold the boundary conditions for the solve.
+
+    const Real fac = (t_new - t_old) / (t_old - hist.t_older);
+
+    MultiFab::Copy(phi_new, phi_old, 0, 0, 1, 0);
+    MultiFab::Saxpy(phi_new, fac, phi_old, 0, 0, 1, 0);
+    MultiFab::Saxpy(phi_new, -fac, *hist.older, 0, 0, 1, 0);
+
+    if (gravity::verbose > 1 && ParallelDescriptor::IOProcessor()) {
+        std::cout << " ... extrapolated the guess for phi at level " << level << std::endl;
+    }
+}
@@ -61,11 +61,17 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
   }
 #endif
 
+  // for the performance report: the number of zones updated and the
+  // largest size of the tile temporaries per zone
+
+  Long zones_advanced = 0;
+  Real bytes_per_zone = 0.0_rt;
+
 #ifdef _OPENMP
 #ifdef RADIATION
-#pragma omp parallel reduction(max:nstep_fsp)
+#pragma omp parallel reduction(max:nstep_fsp) reduction(+:zones_advanced) reduction(max:bytes_per_zone)
 #else
-#pragma omp parallel
+#pragma omp parallel reduction(+:zones_advanced) reduction(max:bytes_per_zone)
 #endif
 #endif
   {
@@ -120,6 +126,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
     FArrayBox qmzy, qpzy;
     FArrayBox qmxz, qpxz;
     FArrayBox qmyz, qpyz;
+    FArrayBox qmt1, qpt1, qmt2, qpt2;
 #endif
 
 #ifdef AMREX_USE_GPU
@@ -285,7 +292,8 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       bool compute_shock = false;
 #endif
 
-      if (hybrid_riemann == 1 || compute_shock) {
+      if (hybrid_riemann == 1 || compute_shock ||
+          (riemann_solver == 1 && riemann_cg_adaptive == 1)) {
         shock(obx, q_arr, shk_arr);
       }
       else {
@@ -327,7 +335,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       // work on the interface states
 
       qxm.resize(obx, NQ, The_Async_Arena());
-      fab_size += shk.nBytes();
+      fab_size += qxm.nBytes();
 
       qxp.resize(obx, NQ, The_Async_Arena());
       fab_size += qxp.nBytes();
@@ -664,447 +672,647 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       const amrex::Real cdtdy = dt/dx[1]/3.0;
       const amrex::Real cdtdz = dt/dx[2]/3.0;
 
-      // compute F^x
-      // [lo(1), lo(2)-1, lo(3)-1], [hi(1)+1, hi(2)+1, hi(3)+1]
-      const Box& cxbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,1)));
+      if (ctu_low_memory == 1) {
 
-      // ftmp1 = fx
-      // rftmp1 = rfx
-      // qgdnvtmp1 = qgdnxv
-      cmpflx_plus_godunov(cxbx,
-                          qxm_arr, qxp_arr,
-                          ftmp1_arr, q_int_arr,
-#ifdef RADIATION
-                          rftmp1_arr, lambda_int_arr,
-#endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          0);
+        // Build the final fluxes one direction at a time. For the
+        // direction idir with transverse directions t1 < t2 we only
+        // need the t1 states corrected by F^t2 and the t2 states
+        // corrected by F^t1, so only two pairs of corner-coupled
+        // states are alive at once (rather than all six). The price
+        // is that each of the normal-predictor fluxes F^x, F^y, F^z
+        // is computed twice.
 
-      // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+1, hi(3)+1]
-      const Box& tyxbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(0,0,1)));
+        const Box nbx[3] = {xbx, ybx, zbx};
 
-      qmyx.resize(tyxbx, NQ, The_Async_Arena());
-      auto qmyx_arr = qmyx.array();
-      fab_size += qmyx.nBytes();
+        Array4<Real> const qm_arr[3] = {qxm_arr, qym_arr, qzm_arr};
+        Array4<Real> const qp_arr[3] = {qxp_arr, qyp_arr, qzp_arr};
 
-      qpyx.resize(tyxbx, NQ, The_Async_Arena());
-      auto qpyx_arr = qpyx.array();
-      fab_size += qpyx.nBytes();
+        const Real hdtd[3] = {hdtdx, hdtdy, hdtdz};
+        const Real cdtd[3] = {cdtdx, cdtdy, cdtdz};
 
-      // ftmp1 = fx
-      // rftmp1 = rfx
-      // qgdnvtmp1 = qgdnvx
-      trans_single(tyxbx, 0, 1,
-                   qym_arr, qmyx_arr,
-                   qyp_arr, qpyx_arr,
-                   qaux_arr,
-                   ftmp1_arr,
-#ifdef RADIATION
-                   rftmp1_arr,
-#endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdx);
+        // With ppm_temp_fix = 2 the Riemann solve for F^d rewrites the
+        // thermodynamics of the d states in place. The default ordering
+        // solves F^x, F^y, and F^z before any of those states are used,
+        // but here, e.g., the x states are used by trans_final before
+        // F^x is ever solved. So we make all of the states consistent up
+        // front, over the same regions as the normal-predictor solves.
 
-      reset_edge_state_thermo(tyxbx, qmyx.array());
+        if (ppm_temp_fix == 2) {
+            for (int d = 0; d < 3; ++d) {
+                IntVect g_d(1);
+                g_d[d] = 0;
+                sync_edge_state_thermo(amrex::grow(nbx[d], g_d), qm_arr[d], qp_arr[d]);
+            }
+        }
 
-      reset_edge_state_thermo(tyxbx, qpyx.array());
+        size_t corner_size = 0;
 
-      // [lo(1), lo(2)-1, lo(3)], [hi(1), hi(2)+1, hi(3)+1]
-      const Box& tzxbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(0,1,0)));
+        for (int idir = 0; idir < 3; ++idir) {
 
-      qmzx.resize(tzxbx, NQ, The_Async_Arena());
-      auto qmzx_arr = qmzx.array();
-      fab_size += qmzx.nBytes();
+          const int t1 = idir == 0 ? 1 : 0;
+          const int t2 = idir == 2 ? 1 : 2;
 
-      qpzx.resize(tzxbx, NQ, The_Async_Arena());
-      auto qpzx_arr = qpzx.array();
-      fab_size += qpzx.nBytes();
+          // the normal-predictor fluxes are needed one zone wide in
+          // both of the other directions, e.g.
+          // F^x: [lo(1), lo(2)-1, lo(3)-1], [hi(1)+1, hi(2)+1, hi(3)+1]
 
-      trans_single(tzxbx, 0, 2,
-                   qzm_arr, qmzx_arr,
-                   qzp_arr, qpzx_arr,
-                   qaux_arr,
-                   ftmp1_arr,
-#ifdef RADIATION
-                   rftmp1_arr,
-#endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdx);
+          IntVect g_t1(1);
+          g_t1[t1] = 0;
 
-      reset_edge_state_thermo(tzxbx, qmzx.array());
+          IntVect g_t2(1);
+          g_t2[t2] = 0;
 
-      reset_edge_state_thermo(tzxbx, qpzx.array());
+          // the corner-coupled states are needed one zone wide in idir, e.g.
+          // q?yz: [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, hi(3)]
 
-      // compute F^y
-      // [lo(1)-1, lo(2), lo(3)-1], [hi(1)+1, hi(2)+1, hi(3)+1]
-      const Box& cybx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,1)));
+          IntVect g_idir(0);
+          g_idir[idir] = 1;
 
-      // ftmp1 = fy
-      // rftmp1 = rfy
-      // qgdnvtmp1 = qgdnvy
-      cmpflx_plus_godunov(cybx,
-                          qym_arr, qyp_arr,
-                          ftmp1_arr, q_int_arr,
-#ifdef RADIATION
-                          rftmp1_arr, lambda_int_arr,
-#endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          1);
+          const Box& tbx1 = amrex::grow(nbx[t1], g_idir);
+          const Box& tbx2 = amrex::grow(nbx[t2], g_idir);
 
-      // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), lo(3)+1]
-      const Box& txybx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,0,1)));
+          qmt1.resize(tbx1, NQ, The_Async_Arena());
+          qpt1.resize(tbx1, NQ, The_Async_Arena());
+          qmt2.resize(tbx2, NQ, The_Async_Arena());
+          qpt2.resize(tbx2, NQ, The_Async_Arena());
 
-      qmxy.resize(txybx, NQ, The_Async_Arena());
-      auto qmxy_arr = qmxy.array();
-      fab_size += qmxy.nBytes();
+          corner_size = std::max(corner_size,
+                                 qmt1.nBytes() + qpt1.nBytes() + qmt2.nBytes() + qpt2.nBytes());
 
-      qpxy.resize(txybx, NQ, The_Async_Arena());
-      auto qpxy_arr = qpxy.array();
-      fab_size += qpxy.nBytes();
+          auto qmt1_arr = qmt1.array();
+          auto qpt1_arr = qpt1.array();
+          auto qmt2_arr = qmt2.array();
+          auto qpt2_arr = qpt2.array();
 
-      // ftmp1 = fy
-      // rftmp1 = rfy
-      // qgdnvtmp1 = qgdnvy
-      trans_single(txybx, 1, 0,
-                   qxm_arr, qmxy_arr,
-                   qxp_arr, qpxy_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+          // F^t2, used to correct the t1 states
+
+          // ftmp1 = f_t2
+          // rftmp1 = rf_t2
+          // qgdnvtmp1 = qgdnv_t2
+          cmpflx_plus_godunov(amrex::grow(nbx[t2], g_t2),
+                              qm_arr[t2], qp_arr[t2],
+                              ftmp1_arr, q_int_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                              rftmp1_arr, lambda_int_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdy);
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              t2);
 
-      reset_edge_state_thermo(txybx, qmxy.array());
+          trans_single(tbx1, t2, t1,
+                       qm_arr[t1], qmt1_arr,
+                       qp_arr[t1], qpt1_arr,
+                       qaux_arr,
+                       ftmp1_arr,
+#ifdef RADIATION
+                       rftmp1_arr,
+#endif
+                       qgdnvtmp1_arr,
+                       hdt, cdtd[t2]);
 
-      reset_edge_state_thermo(txybx, qpxy.array());
+          reset_edge_state_thermo(tbx1, qmt1.array());
 
-      // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2), lo(3)+1]
-      const Box& tzybx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,0,0)));
+          reset_edge_state_thermo(tbx1, qpt1.array());
 
-      qmzy.resize(tzybx, NQ, The_Async_Arena());
-      auto qmzy_arr = qmzy.array();
-      fab_size += qmzy.nBytes();
+          // F^t1, used to correct the t2 states
 
-      qpzy.resize(tzybx, NQ, The_Async_Arena());
-      auto qpzy_arr = qpzy.array();
-      fab_size += qpzy.nBytes();
+          // ftmp1 = f_t1
+          // rftmp1 = rf_t1
+          // qgdnvtmp1 = qgdnv_t1
+          cmpflx_plus_godunov(amrex::grow(nbx[t1], g_t1),
+                              qm_arr[t1], qp_arr[t1],
+                              ftmp1_arr, q_int_arr,
+#ifdef RADIATION
+                              rftmp1_arr, lambda_int_arr,
+#endif
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              t1);
 
-      // ftmp1 = fy
-      // rftmp1 = rfy
-      // qgdnvtmp1 = qgdnvy
-      trans_single(tzybx, 1, 2,
-                   qzm_arr, qmzy_arr,
-                   qzp_arr, qpzy_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+          trans_single(tbx2, t1, t2,
+                       qm_arr[t2], qmt2_arr,
+                       qp_arr[t2], qpt2_arr,
+                       qaux_arr,
+                       ftmp1_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                       rftmp1_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdy);
+                       qgdnvtmp1_arr,
+                       hdt, cdtd[t1]);
 
-      reset_edge_state_thermo(tzybx, qmzy.array());
+          reset_edge_state_thermo(tbx2, qmt2.array());
 
-      reset_edge_state_thermo(tzybx, qpzy.array());
+          reset_edge_state_thermo(tbx2, qpt2.array());
 
-      // compute F^z
-      // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, hi(3)+1]
-      const Box& czbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,1,0)));
+          // the transverse fluxes F^{t1|t2} and F^{t2|t1}
 
-      // ftmp1 = fz
-      // rftmp1 = rfz
-      // qgdnvtmp1 = qgdnvz
-      cmpflx_plus_godunov(czbx,
-                          qzm_arr, qzp_arr,
-                          ftmp1_arr, q_int_arr,
+          // ftmp1 = f_t1t2
+          // rftmp1 = rf_t1t2
+          // qgdnvtmp1 = qgdnv_t1t2
+          cmpflx_plus_godunov(tbx1,
+                              qmt1_arr, qpt1_arr,
+                              ftmp1_arr, q_int_arr,
 #ifdef RADIATION
-                          rftmp1_arr, lambda_int_arr,
+                              rftmp1_arr, lambda_int_arr,
+#endif
+                              qgdnvtmp1_arr,
+                              qaux_arr, shk_arr,
+                              t1);
+
+          // ftmp2 = f_t2t1
+          // rftmp2 = rf_t2t1
+          // qgdnvtmp2 = qgdnv_t2t1
+          cmpflx_plus_godunov(tbx2,
+                              qmt2_arr, qpt2_arr,
+                              ftmp2_arr, q_int_arr,
+#ifdef RADIATION
+                              rftmp2_arr, lambda_int_arr,
 #endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          2);
+                              qgdnvtmp2_arr,
+                              qaux_arr, shk_arr,
+                              t2);
+
+          // compute the corrected interface states and the final fluxes
 
-      // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
-      const Box& txzbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,0)));
+          trans_final(nbx[idir], idir, t1, t2,
+                      qm_arr[idir], ql_arr,
+                      qp_arr[idir], qr_arr,
+                      qaux_arr,
+                      ftmp1_arr,
+#ifdef RADIATION
+                      rftmp1_arr,
+#endif
+                      ftmp2_arr,
+#ifdef RADIATION
+                      rftmp2_arr,
+#endif
+                      qgdnvtmp1_arr,
+                      qgdnvtmp2_arr,
+                      hdtd[t1], hdtd[t2]);
 
-      qmxz.resize(txzbx, NQ, The_Async_Arena());
-      auto qmxz_arr = qmxz.array();
-      fab_size += qmxz.nBytes();
+          reset_edge_state_thermo(nbx[idir], ql.array());
 
-      qpxz.resize(txzbx, NQ, The_Async_Arena());
-      auto qpxz_arr = qpxz.array();
-      fab_size += qpxz.nBytes();
+          reset_edge_state_thermo(nbx[idir], qr.array());
 
-      // ftmp1 = fz
-      // rftmp1 = rfz
-      // qgdnvtmp1 = qgdnvz
-      trans_single(txzbx, 2, 0,
-                   qxm_arr, qmxz_arr,
-                   qxp_arr, qpxz_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+          cmpflx_plus_godunov(nbx[idir],
+                              ql_arr, qr_arr,
+                              flux[idir].array(), q_int_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                              rad_flux[idir].array(), lambda_int_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdz);
-
-      reset_edge_state_thermo(txzbx, qmxz.array());
+                              qe[idir].array(),
+                              qaux_arr, shk_arr,
+                              idir);
 
-      reset_edge_state_thermo(txzbx, qpxz.array());
+        }
 
-      // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
-      const Box& tyzbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,0)));
+        fab_size += corner_size;
 
-      qmyz.resize(tyzbx, NQ, The_Async_Arena());
-      auto qmyz_arr = qmyz.array();
-      fab_size += qmyz.nBytes();
+      } else {
 
-      qpyz.resize(tyzbx, NQ, The_Async_Arena());
-      auto qpyz_arr = qpyz.array();
-      fab_size += qpyz.nBytes();
+        // compute F^x
+        // [lo(1), lo(2)-1, lo(3)-1], [hi(1)+1, hi(2)+1, hi(3)+1]
+        const Box& cxbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,1)));
 
-      // ftmp1 = fz
-      // rftmp1 = rfz
-      // qgdnvtmp1 = qgdnvz
-      trans_single(tyzbx, 2, 1,
-                   qym_arr, qmyz_arr,
-                   qyp_arr, qpyz_arr,
-                   qaux_arr,
-                   ftmp1_arr,
+        // ftmp1 = fx
+        // rftmp1 = rfx
+        // qgdnvtmp1 = qgdnxv
+        cmpflx_plus_godunov(cxbx,
+                            qxm_arr, qxp_arr,
+                            ftmp1_arr, q_int_arr,
 #ifdef RADIATION
-                   rftmp1_arr,
+                            rftmp1_arr, lambda_int_arr,
+#endif
+                            qgdnvtmp1_arr,
+                            qaux_arr, shk_arr,
+                            0);
+
+        // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+1, hi(3)+1]
+        const Box& tyxbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(0,0,1)));
+
+        qmyx.resize(tyxbx, NQ, The_Async_Arena());
+        auto qmyx_arr = qmyx.array();
+        fab_size += qmyx.nBytes();
+
+        qpyx.resize(tyxbx, NQ, The_Async_Arena());
+        auto qpyx_arr = qpyx.array();
+        fab_size += qpyx.nBytes();
+
+        // ftmp1 = fx
+        // rftmp1 = rfx
+        // qgdnvtmp1 = qgdnvx
+        trans_single(tyxbx, 0, 1,
+                     qym_arr, qmyx_arr,
+                     qyp_arr, qpyx_arr,
+                     qaux_arr,
+                     ftmp1_arr,
+#ifdef RADIATION
+                     rftmp1_arr,
 #endif
-                   qgdnvtmp1_arr,
-                   hdt, cdtdz);
+                     qgdnvtmp1_arr,
+                     hdt, cdtdx);
 
-      reset_edge_state_thermo(tyzbx, qmyz.array());
+        reset_edge_state_thermo(tyxbx, qmyx.array());
 
-      reset_edge_state_thermo(tyzbx, qpyz.array());
+        reset_edge_state_thermo(tyxbx, qpyx.array());
 
-      // we now have q?zx, q?yx, q?zy, q?xy, q?yz, q?xz
+        // [lo(1), lo(2)-1, lo(3)], [hi(1), hi(2)+1, hi(3)+1]
+        const Box& tzxbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(0,1,0)));
 
-      //
-      // Use qx?, q?yz, q?zy to compute final x-flux
-      //
+        qmzx.resize(tzxbx, NQ, The_Async_Arena());
+        auto qmzx_arr = qmzx.array();
+        fab_size += qmzx.nBytes();
 
-      // compute F^{y|z}
-      // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, hi(3)]
-      const Box& cyzbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,0)));
+        qpzx.resize(tzxbx, NQ, The_Async_Arena());
+        auto qpzx_arr = qpzx.array();
+        fab_size += qpzx.nBytes();
 
-      // ftmp1 = fyz
-      // rftmp1 = rfyz
-      // qgdnvtmp1 = qgdnvyz
-      cmpflx_plus_godunov(cyzbx,
-                          qmyz_arr, qpyz_arr,
-                          ftmp1_arr, q_int_arr,
+        trans_single(tzxbx, 0, 2,
+                     qzm_arr, qmzx_arr,
+                     qzp_arr, qpzx_arr,
+                     qaux_arr,
+                     ftmp1_arr,
 #ifdef RADIATION
-                          rftmp1_arr, lambda_int_arr,
+                     rftmp1_arr,
 #endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          1);
+                     qgdnvtmp1_arr,
+                     hdt, cdtdx);
 
-      // compute F^{z|y}
-      // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2), hi(3)+1]
-      const Box& czybx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,0,0)));
+        reset_edge_state_thermo(tzxbx, qmzx.array());
 
-      // ftmp2 = fzy
-      // rftmp2 = rfzy
-      // qgdnvtmp2 = qgdnvzy
-      cmpflx_plus_godunov(czybx,
-                          qmzy_arr, qpzy_arr,
-                          ftmp2_arr, q_int_arr,
-#ifdef RADIATION
-                          rftmp2_arr, lambda_int_arr,
-#endif
-                          qgdnvtmp2_arr,
-                          qaux_arr, shk_arr,
-                          2);
+        reset_edge_state_thermo(tzxbx, qpzx.array());
 
-      // compute the corrected x interface states and fluxes
-      // [lo(1), lo(2), lo(3)], [hi(1)+1, hi(2), hi(3)]
+        // compute F^y
+        // [lo(1)-1, lo(2), lo(3)-1], [hi(1)+1, hi(2)+1, hi(3)+1]
+        const Box& cybx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,1)));
 
-      trans_final(xbx, 0, 1, 2,
-                  qxm_arr, ql_arr,
-                  qxp_arr, qr_arr,
-                  qaux_arr,
-                  ftmp1_arr,
+        // ftmp1 = fy
+        // rftmp1 = rfy
+        // qgdnvtmp1 = qgdnvy
+        cmpflx_plus_godunov(cybx,
+                            qym_arr, qyp_arr,
+                            ftmp1_arr, q_int_arr,
+#ifdef RADIATION
+                            rftmp1_arr, lambda_int_arr,
+#endif
+                            qgdnvtmp1_arr,
+                            qaux_arr, shk_arr,
+                            1);
+
+        // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), lo(3)+1]
+        const Box& txybx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,0,1)));
+
+        qmxy.resize(txybx, NQ, The_Async_Arena());
+        auto qmxy_arr = qmxy.array();
+        fab_size += qmxy.nBytes();
+
+        qpxy.resize(txybx, NQ, The_Async_Arena());
+        auto qpxy_arr = qpxy.array();
+        fab_size += qpxy.nBytes();
+
+        // ftmp1 = fy
+        // rftmp1 = rfy
+        // qgdnvtmp1 = qgdnvy
+        trans_single(txybx, 1, 0,
+                     qxm_arr, qmxy_arr,
+                     qxp_arr, qpxy_arr,
+                     qaux_arr,
+                     ftmp1_arr,
 #ifdef RADIATION
-                  rftmp1_arr,
+                     rftmp1_arr,
 #endif
-                  ftmp2_arr,
+                     qgdnvtmp1_arr,
+                     hdt, cdtdy);
+
+        reset_edge_state_thermo(txybx, qmxy.array());
+
+        reset_edge_state_thermo(txybx, qpxy.array());
+
+        // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2), lo(3)+1]
+        const Box& tzybx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,0,0)));
+
+        qmzy.resize(tzybx, NQ, The_Async_Arena());
+        auto qmzy_arr = qmzy.array();
+        fab_size += qmzy.nBytes();
+
+        qpzy.resize(tzybx, NQ, The_Async_Arena());
+        auto qpzy_arr = qpzy.array();
+        fab_size += qpzy.nBytes();
+
+        // ftmp1 = fy
+        // rftmp1 = rfy
+        // qgdnvtmp1 = qgdnvy
+        trans_single(tzybx, 1, 2,
+                     qzm_arr, qmzy_arr,
+                     qzp_arr, qpzy_arr,
+                     qaux_arr,
+                     ftmp1_arr,
 #ifdef RADIATION
-                  rftmp2_arr,
+                     rftmp1_arr,
 #endif
-                  qgdnvtmp1_arr,
-                  qgdnvtmp2_arr,
-                  hdtdy, hdtdz);
+                     qgdnvtmp1_arr,
+                     hdt, cdtdy);
 
-      reset_edge_state_thermo(xbx, ql.array());
+        reset_edge_state_thermo(tzybx, qmzy.array());
 
-      reset_edge_state_thermo(xbx, qr.array());
+        reset_edge_state_thermo(tzybx, qpzy.array());
 
-      cmpflx_plus_godunov(xbx,
-                          ql_arr, qr_arr,
-                          flux0_arr, q_int_arr,
+        // compute F^z
+        // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, hi(3)+1]
+        const Box& czbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,1,0)));
+
+        // ftmp1 = fz
+        // rftmp1 = rfz
+        // qgdnvtmp1 = qgdnvz
+        cmpflx_plus_godunov(czbx,
+                            qzm_arr, qzp_arr,
+                            ftmp1_arr, q_int_arr,
 #ifdef RADIATION
-                          rad_flux0_arr, lambda_int_arr,
+                            rftmp1_arr, lambda_int_arr,
+#endif
+                            qgdnvtmp1_arr,
+                            qaux_arr, shk_arr,
+                            2);
+
+        // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
+        const Box& txzbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,0)));
+
+        qmxz.resize(txzbx, NQ, The_Async_Arena());
+        auto qmxz_arr = qmxz.array();
+        fab_size += qmxz.nBytes();
+
+        qpxz.resize(txzbx, NQ, The_Async_Arena());
+        auto qpxz_arr = qpxz.array();
+        fab_size += qpxz.nBytes();
+
+        // ftmp1 = fz
+        // rftmp1 = rfz
+        // qgdnvtmp1 = qgdnvz
+        trans_single(txzbx, 2, 0,
+                     qxm_arr, qmxz_arr,
+                     qxp_arr, qpxz_arr,
+                     qaux_arr,
+                     ftmp1_arr,
+#ifdef RADIATION
+                     rftmp1_arr,
 #endif
-                          qex_arr,
-                          qaux_arr, shk_arr,
-                          0);
+                     qgdnvtmp1_arr,
+                     hdt, cdtdz);
 
-      //
-      // Use qy?, q?zx, q?xz to compute final y-flux
-      //
+        reset_edge_state_thermo(txzbx, qmxz.array());
 
-      // compute F^{z|x}
-      // [lo(1), lo(2)-1, lo(3)], [hi(1), hi(2)+1, hi(3)+1]
-      const Box& czxbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(0,1,0)));
+        reset_edge_state_thermo(txzbx, qpxz.array());
 
-      // ftmp1 = fzx
-      // rftmp1 = rfzx
-      // qgdnvtmp1 = qgdnvzx
-      cmpflx_plus_godunov(czxbx,
-                          qmzx_arr, qpzx_arr,
-                          ftmp1_arr, q_int_arr,
+        // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
+        const Box& tyzbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,0)));
+
+        qmyz.resize(tyzbx, NQ, The_Async_Arena());
+        auto qmyz_arr = qmyz.array();
+        fab_size += qmyz.nBytes();
+
+        qpyz.resize(tyzbx, NQ, The_Async_Arena());
+        auto qpyz_arr = qpyz.array();
+        fab_size += qpyz.nBytes();
+
+        // ftmp1 = fz
+        // rftmp1 = rfz
+        // qgdnvtmp1 = qgdnvz
+        trans_single(tyzbx, 2, 1,
+                     qym_arr, qmyz_arr,
+                     qyp_arr, qpyz_arr,
+                     qaux_arr,
+                     ftmp1_arr,
 #ifdef RADIATION
-                          rftmp1_arr, lambda_int_arr,
+                     rftmp1_arr,
 #endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          2);
+                     qgdnvtmp1_arr,
+                     hdt, cdtdz);
 
-      // compute F^{x|z}
-      // [lo(1), lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, hi(3)]
-      const Box& cxzbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,0)));
+        reset_edge_state_thermo(tyzbx, qmyz.array());
 
-      // ftmp2 = fxz
-      // rftmp2 = rfxz
-      // qgdnvtmp2 = qgdnvxz
-      cmpflx_plus_godunov(cxzbx,
-                          qmxz_arr, qpxz_arr,
-                          ftmp2_arr, q_int_arr,
+        reset_edge_state_thermo(tyzbx, qpyz.array());
+
+        // we now have q?zx, q?yx, q?zy, q?xy, q?yz, q?xz
+
+        //
+        // Use qx?, q?yz, q?zy to compute final x-flux
+        //
+
+        // compute F^{y|z}
+        // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, hi(3)]
+        const Box& cyzbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,0)));
+
+        // ftmp1 = fyz
+        // rftmp1 = rfyz
+        // qgdnvtmp1 = qgdnvyz
+        cmpflx_plus_godunov(cyzbx,
+                            qmyz_arr, qpyz_arr,
+                            ftmp1_arr, q_int_arr,
 #ifdef RADIATION
-                          rftmp2_arr, lambda_int_arr,
+                            rftmp1_arr, lambda_int_arr,
+#endif
+                            qgdnvtmp1_arr,
+                            qaux_arr, shk_arr,
+                            1);
+
+        // compute F^{z|y}
+        // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2), hi(3)+1]
+        const Box& czybx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,0,0)));
+
+        // ftmp2 = fzy
+        // rftmp2 = rfzy
+        // qgdnvtmp2 = qgdnvzy
+        cmpflx_plus_godunov(czybx,
+                            qmzy_arr, qpzy_arr,
+                            ftmp2_arr, q_int_arr,
+#ifdef RADIATION
+                            rftmp2_arr, lambda_int_arr,
 #endif
-                          qgdnvtmp2_arr,
-                          qaux_arr, shk_arr,
-                          0);
+                            qgdnvtmp2_arr,
+                            qaux_arr, shk_arr,
+                            2);
 
-      // Compute the corrected y interface states and fluxes
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
+        // compute the corrected x interface states and fluxes
+        // [lo(1), lo(2), lo(3)], [hi(1)+1, hi(2), hi(3)]
 
-      trans_final(ybx, 1, 0, 2,
-                  qym_arr, ql_arr,
-                  qyp_arr, qr_arr,
-                  qaux_arr,
-                  ftmp2_arr,
+        trans_final(xbx, 0, 1, 2,
+                    qxm_arr, ql_arr,
+                    qxp_arr, qr_arr,
+                    qaux_arr,
+                    ftmp1_arr,
 #ifdef RADIATION
-                  rftmp2_arr,
+                    rftmp1_arr,
 #endif
-                  ftmp1_arr,
+                    ftmp2_arr,
 #ifdef RADIATION
-                  rftmp1_arr,
+                    rftmp2_arr,
 #endif
-                  qgdnvtmp2_arr,
-                  qgdnvtmp1_arr,
-                  hdtdx, hdtdz);
+                    qgdnvtmp1_arr,
+                    qgdnvtmp2_arr,
+                    hdtdy, hdtdz);
 
-      reset_edge_state_thermo(ybx, ql.array());
+        reset_edge_state_thermo(xbx, ql.array());
 
-      reset_edge_state_thermo(ybx, qr.array());
+        reset_edge_state_thermo(xbx, qr.array());
 
-      // Compute the final F^y
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
-      cmpflx_plus_godunov(ybx,
-                          ql_arr, qr_arr,
-                          flux1_arr, q_int_arr,
+        cmpflx_plus_godunov(xbx,
+                            ql_arr, qr_arr,
+                            flux0_arr, q_int_arr,
 #ifdef RADIATION
-                          rad_flux1_arr, lambda_int_arr,
+                            rad_flux0_arr, lambda_int_arr,
+#endif
+                            qex_arr,
+                            qaux_arr, shk_arr,
+                            0);
+
+        //
+        // Use qy?, q?zx, q?xz to compute final y-flux
+        //
+
+        // compute F^{z|x}
+        // [lo(1), lo(2)-1, lo(3)], [hi(1), hi(2)+1, hi(3)+1]
+        const Box& czxbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(0,1,0)));
+
+        // ftmp1 = fzx
+        // rftmp1 = rfzx
+        // qgdnvtmp1 = qgdnvzx
+        cmpflx_plus_godunov(czxbx,
+                            qmzx_arr, qpzx_arr,
+                            ftmp1_arr, q_int_arr,
+#ifdef RADIATION
+                            rftmp1_arr, lambda_int_arr,
+#endif
+                            qgdnvtmp1_arr,
+                            qaux_arr, shk_arr,
+                            2);
+
+        // compute F^{x|z}
+        // [lo(1), lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, hi(3)]
+        const Box& cxzbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,0)));
+
+        // ftmp2 = fxz
+        // rftmp2 = rfxz
+        // qgdnvtmp2 = qgdnvxz
+        cmpflx_plus_godunov(cxzbx,
+                            qmxz_arr, qpxz_arr,
+                            ftmp2_arr, q_int_arr,
+#ifdef RADIATION
+                            rftmp2_arr, lambda_int_arr,
 #endif
-                          qey_arr,
-                          qaux_arr, shk_arr,
-                          1);
-
-      //
-      // Use qz?, q?xy, q?yx to compute final z-flux
-      //
+                            qgdnvtmp2_arr,
+                            qaux_arr, shk_arr,
+                            0);
 
-      // compute F^{x|y}
-      // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), hi(3)+1]
-      const Box& cxybx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,0,1)));
+        // Compute the corrected y interface states and fluxes
+        // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
 
-      // ftmp1 = fxy
-      // rftmp1 = rfxy
-      // qgdnvtmp1 = qgdnvxy
-      cmpflx_plus_godunov(cxybx,
-                          qmxy_arr, qpxy_arr,
-                          ftmp1_arr, q_int_arr,
+        trans_final(ybx, 1, 0, 2,
+                    qym_arr, ql_arr,
+                    qyp_arr, qr_arr,
+                    qaux_arr,
+                    ftmp2_arr,
 #ifdef RADIATION
-                          rftmp1_arr, lambda_int_arr,
+                    rftmp2_arr,
 #endif
-                          qgdnvtmp1_arr,
-                          qaux_arr, shk_arr,
-                          0);
+                    ftmp1_arr,
+#ifdef RADIATION
+                    rftmp1_arr,
+#endif
+                    qgdnvtmp2_arr,
+                    qgdnvtmp1_arr,
+                    hdtdx, hdtdz);
 
-      // compute F^{y|x}
-      // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+dg(2), hi(3)+1]
-      const Box& cyxbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(0,0,1)));
+        reset_edge_state_thermo(ybx, ql.array());
 
-      // ftmp2 = fyx
-      // rftmp2 = rfyx
-      // qgdnvtmp2 = qgdnvyx
-      cmpflx_plus_godunov(cyxbx,
-                          qmyx_arr, qpyx_arr,
-                          ftmp2_arr, q_int_arr,
+        reset_edge_state_thermo(ybx, qr.array());
+
+        // Compute the final F^y
+        // [lo(1), lo(2), lo(3)], [hi(1), hi(2)+1, hi(3)]
+        cmpflx_plus_godunov(ybx,
+                            ql_arr, qr_arr,
+                            flux1_arr, q_int_arr,
 #ifdef RADIATION
-                          rftmp2_arr, lambda_int_arr,
+                            rad_flux1_arr, lambda_int_arr,
+#endif
+                            qey_arr,
+                            qaux_arr, shk_arr,
+                            1);
+
+        //
+        // Use qz?, q?xy, q?yx to compute final z-flux
+        //
+
+        // compute F^{x|y}
+        // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), hi(3)+1]
+        const Box& cxybx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,0,1)));
+
+        // ftmp1 = fxy
+        // rftmp1 = rfxy
+        // qgdnvtmp1 = qgdnvxy
+        cmpflx_plus_godunov(cxybx,
+                            qmxy_arr, qpxy_arr,
+                            ftmp1_arr, q_int_arr,
+#ifdef RADIATION
+                            rftmp1_arr, lambda_int_arr,
+#endif
+                            qgdnvtmp1_arr,
+                            qaux_arr, shk_arr,
+                            0);
+
+        // compute F^{y|x}
+        // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+dg(2), hi(3)+1]
+        const Box& cyxbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(0,0,1)));
+
+        // ftmp2 = fyx
+        // rftmp2 = rfyx
+        // qgdnvtmp2 = qgdnvyx
+        cmpflx_plus_godunov(cyxbx,
+                            qmyx_arr, qpyx_arr,
+                            ftmp2_arr, q_int_arr,
+#ifdef RADIATION
+                            rftmp2_arr, lambda_int_arr,
 #endif
-                          qgdnvtmp2_arr,
-                          qaux_arr, shk_arr,
-                          1);
+                            qgdnvtmp2_arr,
+                            qaux_arr, shk_arr,
+                            1);
 
-      // compute the corrected z interface states and fluxes
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
+        // compute the corrected z interface states and fluxes
+        // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
 
-      trans_final(zbx, 2, 0, 1,
-                  qzm_arr, ql_arr,
-                  qzp_arr, qr_arr,
-                  qaux_arr,
-                  ftmp1_arr,
+        trans_final(zbx, 2, 0, 1,
+                    qzm_arr, ql_arr,
+                    qzp_arr, qr_arr,
+                    qaux_arr,
+                    ftmp1_arr,
 #ifdef RADIATION
-                  rftmp1_arr,
+                    rftmp1_arr,
 #endif
-                  ftmp2_arr,
+                    ftmp2_arr,
 #ifdef RADIATION
-                  rftmp2_arr,
+                    rftmp2_arr,
 #endif
-                  qgdnvtmp1_arr,
-                  qgdnvtmp2_arr,
-                  hdtdx, hdtdy);
+                    qgdnvtmp1_arr,
+                    qgdnvtmp2_arr,
+                    hdtdx, hdtdy);
 
-      reset_edge_state_thermo(zbx, ql.array());
+        reset_edge_state_thermo(zbx, ql.array());
 
-      reset_edge_state_thermo(zbx, qr.array());
+        reset_edge_state_thermo(zbx, qr.array());
 
-      // compute the final z fluxes F^z
-      // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
+        // compute the final z fluxes F^z
+        // [lo(1), lo(2), lo(3)], [hi(1), hi(2), hi(3)+1]
 
-      cmpflx_plus_godunov(zbx,
-                          ql_arr, qr_arr,
-                          flux2_arr, q_int_arr,
+        cmpflx_plus_godunov(zbx,
+                            ql_arr, qr_arr,
+                            flux2_arr, q_int_arr,
 #ifdef RADIATION
-                          rad_flux2_arr, lambda_int_arr,
+                            rad_flux2_arr, lambda_int_arr,
 #endif
-                          qez_arr,
-                          qaux_arr, shk_arr,
-                          2);
+                            qez_arr,
+                            qaux_arr, shk_arr,
+                            2);
+
+      }
 
 #endif // 3-d
 
@@ -1129,6 +1337,14 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 #endif
           });
 
+          // the passively-advected quantities were not traced, so
+          // construct their fluxes from the final mass flux
+
+          if (split_passive_advection == 1) {
+              passive_upwind_fluxes(nbx, idir, q_arr, flatn_arr,
+                                    qe[idir].array(), flux_arr, dt);
+          }
+
           apply_av(nbx, idir, div_arr, uin_arr, flux_arr);
 
 #ifdef RADIATION
@@ -1357,6 +1573,10 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
       } // idir loop
 
+      zones_advanced += bx.numPts();
+      bytes_per_zone = amrex::max(bytes_per_zone,
+                                  static_cast<Real>(fab_size) / static_cast<Real>(bx.numPts()));
+
 #ifdef AMREX_USE_GPU
       // Check if we're going to run out of memory in the next MFIter iteration.
       // If so, do a synchronize here so that we don't oversubscribe GPU memory.
@@ -1426,6 +1646,10 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
   }
 #endif
 
+  if (verbose && riemann_solver == 1 && riemann_cg_adaptive == 1) {
+    print_riemann_counts();
+  }
+
   if (verbose && ParallelDescriptor::IOProcessor())
     std::cout << "... Leaving construct_ctu_hydro_source()" << std::endl << std::endl;
 
@@ -1438,9 +1662,14 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       Lazy::QueueReduction( [=] () mutable {
 #endif
         ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+        ParallelDescriptor::ReduceLongSum(zones_advanced,IOProc);
+        ParallelDescriptor::ReduceRealMax(bytes_per_zone,IOProc);
 
-        if (ParallelDescriptor::IOProcessor())
-          std::cout << "Castro::construct_ctu_hydro_source() time = " << run_time << "\n" << "\n";
+        if (ParallelDescriptor::IOProcessor()) {
+          std::cout << "Castro::construct_ctu_hydro_source() time = " << run_time << "\n";
+          std::cout << "    zones/sec = " << static_cast<Real>(zones_advanced) / run_time
+                    << ", temporaries = " << bytes_per_zone << " bytes/zone" << "\n" << "\n";
+        }
 #ifdef BL_LAZY
         });
 #endif
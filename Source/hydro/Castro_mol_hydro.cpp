@@ -49,8 +49,20 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
   GeometryData geomdata = geom.data();
 #endif
 
+  // The fourth-order method works on tile boxes just like the
+  // second-order method, but the transverse Laplacian of the face
+  // averages uses one-sided stencils at physical boundaries that reach
+  // three zones into the tile, so we need tiles at least that wide.
+
+  IntVect mol_tile_size = hydro_tile_size;
+  if (sdc_order == 4) {
+      mol_tile_size.max(IntVect(AMREX_D_DECL(3, 3, 3)));
+  }
+
+  Long zones_advanced = 0;
+
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel reduction(+:zones_advanced)
 #endif
   {
 
@@ -77,11 +89,12 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
 #endif
     FArrayBox avis;
 
-    // The fourth order stuff cannot do tiling because of the Laplacian corrections
-    for (MFIter mfi(S_new, (sdc_order == 4) ? no_tile_size : hydro_tile_size); mfi.isValid(); ++mfi)
+    for (MFIter mfi(S_new, mol_tile_size); mfi.isValid(); ++mfi)
       {
         const Box& bx  = mfi.tilebox();
 
+        zones_advanced += bx.numPts();
+
         const Box& obx = amrex::grow(bx, 1);
         const Box& obx2 = amrex::grow(bx, 2);
 
@@ -142,7 +155,8 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
         bool compute_shock = false;
 #endif
 
-        if (hybrid_riemann == 1 || compute_shock) {
+        if (hybrid_riemann == 1 || compute_shock ||
+            (riemann_solver == 1 && riemann_cg_adaptive == 1)) {
           shock(obx, q_arr, shk_arr);
         }
         else {
@@ -258,7 +272,7 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
             riemann_state(ibx[idir],
                           qm_arr, qp_arr,
                           q_avg_arr,
-                          qaux_arr,
+                          qaux_arr, shk_arr,
                           idir, 0);
 
             compute_flux_q(ibx[idir], q_avg_arr, f_avg_arr, idir, 0);
@@ -753,6 +767,10 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
   if (verbose)
     flush_output();
 
+  if (verbose && riemann_solver == 1 && riemann_cg_adaptive == 1) {
+    print_riemann_counts();
+  }
+
 
   if (print_update_diagnostics) {
       evaluate_and_print_source_change(A_update, dt, "hydro source");
@@ -767,9 +785,12 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
         Lazy::QueueReduction( [=] () mutable {
 #endif
         ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+        ParallelDescriptor::ReduceLongSum(zones_advanced,IOProc);
 
-        if (ParallelDescriptor::IOProcessor())
-          std::cout << "Castro::construct_mol_hydro_source() time = " << run_time << "\n" << "\n";
+        if (ParallelDescriptor::IOProcessor()) {
+          std::cout << "Castro::construct_mol_hydro_source() time = " << run_time << "\n";
+          std::cout << "    zones/sec = " << static_cast<Real>(zones_advanced) / run_time << "\n" << "\n";
+        }
 #ifdef BL_LAZY
         });
 #endif
@@ -7,6 +7,7 @@
 
 #include <Castro_util.H>
 #include <advection_util.H>
+#include <slope.H>
 
 #ifdef HYBRID_MOMENTUM
 #include <hybrid.H>
@@ -613,6 +614,145 @@ Castro::normalize_species_fluxes(const Box& bx,
 }
 
 
+void
+Castro::passive_upwind_fluxes(const Box& bx, const int idir,
+                              Array4<Real const> const& q_arr,
+                              Array4<Real const> const& flatn,
+                              Array4<Real const> const& qgdnv,
+                              Array4<Real> const& flux,
+                              const Real dt) {
+
+  // With castro.split_passive_advection = 1 the CTU predictor and the
+  // transverse corrections do not work on the passively-advected
+  // quantities (advected quantities, species, auxiliary variables),
+  // so here we construct their fluxes from the final Godunov mass
+  // flux.  Each quantity is reconstructed with limited linear slopes
+  // in the upwind zone, traced to the interface over dt/2, and
+  // carried by the mass flux.  As in the CTU hydro, the interface value
+  // also gets the transverse (corner) upwind correction: the zone
+  // average is replaced by a weighted average over the upwind zone and
+  // its neighbors upwind in the transverse directions, weighted by the
+  // transverse CFL numbers.  Without it, the unsplit update is only
+  // stable for the sum of the CFL numbers below 1.  Since every
+  // quantity uses the same mass flux and weights, the species fluxes
+  // sum to the mass flux up to the slope limiting, and
+  // normalize_species_fluxes then restores that exactly.
+
+  const auto dx = geom.CellSizeArray();
+  const Real dtdx = dt / dx[idir];
+
+  const int first_order = first_order_hydro;
+
+  amrex::ParallelFor(bx,
+  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+  {
+
+    const Real mass_flux = flux(i,j,k,URHO);
+
+    // the upwind zone, taken from the direction of the mass flux
+
+    const int d = mass_flux >= 0.0_rt ? -1 : 0;
+
+    int iu = i;
+    int ju = j;
+    int ku = k;
+
+    int is = 0;
+    int js = 0;
+    int ks = 0;
+
+    if (idir == 0) {
+      iu += d;
+      is = 1;
+    } else if (idir == 1) {
+      ju += d;
+      js = 1;
+    } else {
+      ku += d;
+      ks = 1;
+    }
+
+    // fraction of the upwind zone swept out by the interface
+    // characteristic over the timestep
+
+    const Real cfl = amrex::min(std::abs(qgdnv(i,j,k,GDU+idir)) * dtdx, 1.0_rt);
+
+    const Real flat = flatn(iu,ju,ku);
+
+    // transverse upwind offsets and weights, using the velocity in the
+    // upwind zone
+
+    int o1[3] = {0, 0, 0};
+    int o2[3] = {0, 0, 0};
+
+    Real w1[2] = {1.0_rt, 0.0_rt};
+    Real w2[2] = {1.0_rt, 0.0_rt};
+
+#if AMREX_SPACEDIM >= 2
+    {
+      const int t1 = idir == 0 ? 1 : 0;
+      const Real v1 = q_arr(iu,ju,ku,QU+t1);
+      const Real c1 = amrex::min(std::abs(v1) * dt / dx[t1], 1.0_rt);
+      o1[t1] = v1 >= 0.0_rt ? -1 : 1;
+      w1[0] = 1.0_rt - 0.5_rt * c1;
+      w1[1] = 0.5_rt * c1;
+    }
+#endif
+#if AMREX_SPACEDIM == 3
+    {
+      const int t2 = idir == 2 ? 1 : 2;
+      const Real v2 = q_arr(iu,ju,ku,QU+t2);
+      const Real c2 = amrex::min(std::abs(v2) * dt / dx[t2], 1.0_rt);
+      o2[t2] = v2 >= 0.0_rt ? -1 : 1;
+      w2[0] = 1.0_rt - 0.5_rt * c2;
+      w2[1] = 0.5_rt * c2;
+    }
+#endif
+
+    Real s[5];
+
+    for (int ipassive = 0; ipassive < npassive; ipassive++) {
+      int n = upassmap(ipassive);
+      int nqp = qpassmap(ipassive);
+
+      s[im2] = q_arr(iu-2*is,ju-2*js,ku-2*ks,nqp);
+      s[im1] = q_arr(iu-is,ju-js,ku-ks,nqp);
+      s[i0]  = q_arr(iu,ju,ku,nqp);
+      s[ip1] = q_arr(iu+is,ju+js,ku+ks,nqp);
+      s[ip2] = q_arr(iu+2*is,ju+2*js,ku+2*ks,nqp);
+
+      Real dq = 0.0_rt;
+      if (first_order == 0) {
+        dq = uslope(s, flat, false, false);
+      }
+
+      // the corner-coupled average of the upwind zone
+
+      Real q_ctu = 0.0_rt;
+
+      for (int b = 0; b <= 1; b++) {
+        for (int a = 0; a <= 1; a++) {
+          const Real wt = w1[a] * w2[b];
+          if (wt == 0.0_rt) continue;
+
+          q_ctu += wt * q_arr(iu + a*o1[0] + b*o2[0],
+                              ju + a*o1[1] + b*o2[1],
+                              ku + a*o1[2] + b*o2[2], nqp);
+        }
+      }
+
+      // the interface is on the right of the upwind zone if d = -1
+      // and on the left if d = 0
+
+      const Real q_face = d == -1 ? q_ctu + 0.5_rt * (1.0_rt - cfl) * dq :
+                                    q_ctu - 0.5_rt * (1.0_rt - cfl) * dq;
+
+      flux(i,j,k,n) = mass_flux * q_face;
+    }
+  });
+}
+
+
 void
 Castro::scale_flux(const Box& bx,
 #if AMREX_SPACEDIM == 1
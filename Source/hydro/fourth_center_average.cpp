@@ -204,3 +204,105 @@ Castro::make_fourth_in_place_n(const Box& bx,
   });
 
 }
+
+
+void
+Castro::make_cell_center_in_place(MultiFab& U, const int ng) {
+
+  // Take a cell-average state U and make it cell-centered in place
+  // via U <- U - 1/24 L U on the valid region plus ng ghost cells.
+  // Unlike the single-box version above, this is tile safe.
+
+  MultiFab lap(U.boxArray(), U.DistributionMap(), 1, ng);
+
+  for (int n = 0; n < U.nComp(); n++) {
+    add_laplacian_in_place(U, n, ng, -1.0_rt/24.0_rt, lap);
+  }
+}
+
+
+void
+Castro::make_fourth_in_place(MultiFab& q, const int ng) {
+
+  // Take the cell-center q and make it a cell-average q, in place,
+  // q <- q + 1/24 L q, on the valid region plus ng ghost cells.
+  // Unlike the single-box version above, this is tile safe.
+
+  MultiFab lap(q.boxArray(), q.DistributionMap(), 1, ng);
+
+  for (int n = 0; n < q.nComp(); n++) {
+    add_laplacian_in_place(q, n, ng, 1.0_rt/24.0_rt, lap);
+  }
+}
+
+
+void
+Castro::make_fourth_in_place_n(MultiFab& q, const int ncomp) {
+
+  // Tile-safe version of make_fourth_in_place_n, operating on the
+  // valid region of component ncomp only.
+
+  MultiFab lap(q.boxArray(), q.DistributionMap(), 1, 0);
+
+  add_laplacian_in_place(q, ncomp, 0, 1.0_rt/24.0_rt, lap);
+}
+
+
+void
+Castro::add_laplacian_in_place(MultiFab& U, const int ncomp, const int ng,
+                               const Real coeff, MultiFab& lap) {
+
+  // Update U <- U + coeff L U for component ncomp on the valid region
+  // plus ng ghost cells.  The Laplacian stencil reaches into the
+  // neighboring tiles, so we compute L U for all of the tiles first,
+  // storing it in lap, and only then update U.  This way no tile ever
+  // reads data that another tile has already overwritten.
+
+  auto domlo = geom.Domain().loVect3d();
+  auto domhi = geom.Domain().hiVect3d();
+
+  const int* lo_bc = phys_bc.lo();
+  const int* hi_bc = phys_bc.hi();
+
+  GpuArray<bool, AMREX_SPACEDIM> lo_periodic;
+  GpuArray<bool, AMREX_SPACEDIM> hi_periodic;
+  for (int idir = 0; idir < AMREX_SPACEDIM; idir++) {
+    lo_periodic[idir] = lo_bc[idir] == Interior;
+    hi_periodic[idir] = hi_bc[idir] == Interior;
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+  for (MFIter mfi(U, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+    const Box& bx = mfi.growntilebox(ng);
+
+    Array4<Real const> const U_arr = U.array(mfi);
+    Array4<Real> const lap_arr = lap.array(mfi);
+
+    amrex::ParallelFor(bx,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k)
+    {
+      lap_arr(i,j,k) = compute_laplacian(i, j, k, ncomp, U_arr,
+                                         lo_periodic, hi_periodic, domlo, domhi);
+    });
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+  for (MFIter mfi(U, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+    const Box& bx = mfi.growntilebox(ng);
+
+    Array4<Real> const U_arr = U.array(mfi);
+    Array4<Real const> const lap_arr = lap.array(mfi);
+
+    amrex::ParallelFor(bx,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k)
+    {
+      U_arr(i,j,k,ncomp) += coeff * lap_arr(i,j,k);
+    });
+  }
+}
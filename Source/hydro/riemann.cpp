@@ -9,6 +9,8 @@
 
 #include <cmath>
 
+#include <AMReX_Scan.H>
+
 #include <eos.H>
 using namespace amrex;
 
@@ -43,7 +45,7 @@ Castro::cmpflx_plus_godunov(const Box& bx,
 #ifdef RADIATION
                   lambda_int,
 #endif
-                  qaux_arr,
+                  qaux_arr, shk,
                   idir, 0);
 
     compute_flux_q(bx,
@@ -139,6 +141,69 @@ Castro::cmpflx_plus_godunov(const Box& bx,
 }
 
 
+void
+Castro::sync_edge_state_thermo(const Box& bx,
+                               Array4<Real> const& qm,
+                               Array4<Real> const& qp) {
+
+  // recompute the thermodynamics on the interface to make it
+  // all consistent
+
+  // we want to take the edge states of rho, e, and X, and get
+  // new values for p on the edges that are
+  // thermodynamically consistent.
+
+  const Real lT_guess = T_guess;
+
+  amrex::ParallelFor(bx,
+  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+  {
+
+   eos_t eos_state;
+
+   // this is an initial guess for iterations, since we
+   // can't be certain what temp is on interfaces
+   eos_state.T = lT_guess;
+
+   // minus state
+   eos_state.rho = qm(i,j,k,QRHO);
+   eos_state.p = qm(i,j,k,QPRES);
+   eos_state.e = qm(i,j,k,QREINT)/qm(i,j,k,QRHO);
+   for (int n = 0; n < NumSpec; n++) {
+     eos_state.xn[n] = qm(i,j,k,QFS+n);
+   }
+#if NAUX_NET > 0
+   for (int n = 0; n < NumAux; n++) {
+     eos_state.aux[n] = qm(i,j,k,QFX+n);
+   }
+#endif
+
+   eos(eos_input_re, eos_state);
+
+   qm(i,j,k,QREINT) = eos_state.e * eos_state.rho;
+   qm(i,j,k,QPRES) = eos_state.p;
+
+   // plus state
+   eos_state.rho = qp(i,j,k,QRHO);
+   eos_state.p = qp(i,j,k,QPRES);
+   eos_state.e = qp(i,j,k,QREINT)/qp(i,j,k,QRHO);
+   for (int n = 0; n < NumSpec; n++) {
+     eos_state.xn[n] = qp(i,j,k,QFS+n);
+   }
+#if NAUX_NET > 0
+   for (int n = 0; n < NumAux; n++) {
+     eos_state.aux[n] = qp(i,j,k,QFX+n);
+   }
+#endif
+
+   eos(eos_input_re, eos_state);
+
+   qp(i,j,k,QREINT) = eos_state.e * eos_state.rho;
+   qp(i,j,k,QPRES) = eos_state.p;
+  });
+}
+
+
 void
 Castro::riemann_state(const Box& bx,
                       Array4<Real> const& qm,
@@ -148,6 +213,7 @@ Castro::riemann_state(const Box& bx,
                       Array4<Real> const& lambda_int,
 #endif
                       Array4<Real const> const& qaux_arr,
+                      Array4<Real const> const& shk,
                       const int idir, const int compute_gammas) {
 
   // just compute the hydrodynamic state on the interfaces
@@ -179,61 +245,7 @@ Castro::riemann_state(const Box& bx,
 #endif
 
   if (ppm_temp_fix == 2) {
-    // recompute the thermodynamics on the interface to make it
-    // all consistent
-
-    // we want to take the edge states of rho, e, and X, and get
-    // new values for p on the edges that are
-    // thermodynamically consistent.
-
-    const Real lT_guess = T_guess;
-
-    amrex::ParallelFor(bx,
-    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
-    {
-
-     eos_t eos_state;
-
-     // this is an initial guess for iterations, since we
-     // can't be certain what temp is on interfaces
-     eos_state.T = lT_guess;
-
-     // minus state
-     eos_state.rho = qm(i,j,k,QRHO);
-     eos_state.p = qm(i,j,k,QPRES);
-     eos_state.e = qm(i,j,k,QREINT)/qm(i,j,k,QRHO);
-     for (int n = 0; n < NumSpec; n++) {
-       eos_state.xn[n] = qm(i,j,k,QFS+n);
-     }
-#if NAUX_NET > 0
-     for (int n = 0; n < NumAux; n++) {
-       eos_state.aux[n] = qm(i,j,k,QFX+n);
-     }
-#endif
-
-     eos(eos_input_re, eos_state);
-
-     qm(i,j,k,QREINT) = eos_state.e * eos_state.rho;
-     qm(i,j,k,QPRES) = eos_state.p;
-
-     // plus state
-     eos_state.rho = qp(i,j,k,QRHO);
-     eos_state.p = qp(i,j,k,QPRES);
-     eos_state.e = qp(i,j,k,QREINT)/qp(i,j,k,QRHO);
-     for (int n = 0; n < NumSpec; n++) {
-       eos_state.xn[n] = qp(i,j,k,QFS+n);
-     }
-#if NAUX_NET > 0
-     for (int n = 0; n < NumAux; n++) {
-       eos_state.aux[n] = qp(i,j,k,QFX+n);
-     }
-#endif
-
-     eos(eos_input_re, eos_state);
-
-     qp(i,j,k,QREINT) = eos_state.e * eos_state.rho;
-     qp(i,j,k,QPRES) = eos_state.p;
-    });
+    sync_edge_state_thermo(bx, qm, qp);
   }
 
   // Solve Riemann problem
@@ -252,10 +264,17 @@ Castro::riemann_state(const Box& bx,
     // Colella & Glaz solver
 
 #ifndef RADIATION
-    riemanncg(bx,
-              qm, qp,
-              qaux_arr, qint,
-              idir);
+    if (riemann_cg_adaptive == 1) {
+      riemanncg_adaptive(bx,
+                         qm, qp,
+                         qaux_arr, qint,
+                         shk, idir);
+    } else {
+      riemanncg(bx,
+                qm, qp,
+                qaux_arr, qint,
+                idir);
+    }
 #endif
 
 #ifndef AMREX_USE_GPU
@@ -264,3 +283,165 @@ Castro::riemann_state(const Box& bx,
 #endif
   }
 }
+
+
+
+#ifndef RADIATION
+void
+Castro::riemanncg_adaptive(const Box& bx,
+                           Array4<Real> const& ql,
+                           Array4<Real> const& qr,
+                           Array4<Real const> const& qaux_arr,
+                           Array4<Real> const& qint,
+                           Array4<Real const> const& shk,
+                           const int idir) {
+
+  // Most interfaces in a typical problem are smooth, and there the
+  // two-shock CGF solver gives essentially the same star state as
+  // the full Colella & Glaz iteration.  So we solve everywhere with
+  // CGF first, then flag the interfaces that are in a shock
+  // (strong) or have a large pressure jump (weak), gather them into
+  // a compact list, and redo only those with the CG solver.  This
+  // keeps the expensive iteration from diverging across the warp /
+  // vector lanes of the smooth flow.
+
+  riemannus(bx,
+            ql, qr,
+            qaux_arr, qint,
+            idir, 0);
+
+  const Real pjump = riemann_cg_pjump;
+  const Real lsmall_pres = small_pres;
+
+  const auto lo = amrex::lbound(bx);
+  const auto len = amrex::length(bx);
+  const int npts = static_cast<int>(bx.numPts());
+
+  // 0 = smooth, 1 = weak, 2 = strong
+
+  Gpu::DeviceVector<int> flag(npts);
+  int* const flag_ptr = flag.dataPtr();
+
+  ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
+  ReduceData<int, int> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
+  reduce_op.eval(bx, reduce_data,
+  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
+  {
+    Real shk_sum;
+    if (idir == 0) {
+      shk_sum = shk(i-1,j,k) + shk(i,j,k);
+    } else if (idir == 1) {
+      shk_sum = shk(i,j-1,k) + shk(i,j,k);
+    } else {
+      shk_sum = shk(i,j,k-1) + shk(i,j,k);
+    }
+
+    const Real pl = ql(i,j,k,QPRES);
+    const Real pr = qr(i,j,k,QPRES);
+    const Real dp = std::abs(pl - pr) / amrex::max(amrex::min(pl, pr), lsmall_pres);
+
+    int is_weak = 0;
+    int is_strong = 0;
+
+    if (shk_sum > 0.0_rt) {
+      is_strong = 1;
+    } else if (dp > pjump) {
+      is_weak = 1;
+    }
+
+    const int n = (i - lo.x) + len.x * ((j - lo.y) + len.y * (k - lo.z));
+    flag_ptr[n] = is_weak + 2 * is_strong;
+
+    return {is_weak, is_strong};
+  });
+
+  ReduceTuple hv = reduce_data.value();
+  const int nweak = amrex::get<0>(hv);
+  const int nstrong = amrex::get<1>(hv);
+  const int nhard = nweak + nstrong;
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  num_riemann_smooth += npts - nhard;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  num_riemann_weak += nweak;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  num_riemann_strong += nstrong;
+
+  if (nhard == 0) {
+    return;
+  }
+
+  if (nhard == npts) {
+    // nothing to gain from compacting
+    riemanncg(bx,
+              ql, qr,
+              qaux_arr, qint,
+              idir);
+    return;
+  }
+
+  // compact the flagged interfaces into a list
+
+  Gpu::DeviceVector<Dim3> cells(nhard);
+  Dim3* const cells_ptr = cells.dataPtr();
+
+  Scan::PrefixSum<int>(npts,
+  [=] AMREX_GPU_DEVICE (int n) -> int
+  {
+    return flag_ptr[n] > 0;
+  },
+  [=] AMREX_GPU_DEVICE (int n, int const& s)
+  {
+    if (flag_ptr[n] > 0) {
+      const int ii = n % len.x;
+      const int jj = (n / len.x) % len.y;
+      const int kk = n / (len.x * len.y);
+      cells_ptr[s] = Dim3{lo.x + ii, lo.y + jj, lo.z + kk};
+    }
+  },
+  Scan::Type::exclusive, Scan::noRetSum);
+
+  riemanncg(bx,
+            ql, qr,
+            qaux_arr, qint,
+            idir,
+            cells_ptr, nhard);
+
+  // the work lists go out of scope here
+
+  Gpu::streamSynchronize();
+}
+#endif
+
+
+
+void
+Castro::print_riemann_counts()
+{
+  Long counts[3] = {num_riemann_smooth, num_riemann_weak, num_riemann_strong};
+
+  num_riemann_smooth = 0;
+  num_riemann_weak = 0;
+  num_riemann_strong = 0;
+
+  ParallelDescriptor::ReduceLongSum(counts, 3);
+
+  const Long total = counts[0] + counts[1] + counts[2];
+
+  if (total > 0) {
+    amrex::Print() << "... Riemann interfaces on level " << level
+                   << ": smooth (CGF) = " << counts[0]
+                   << ", weak (CG) = " << counts[1]
+                   << ", strong (CG) = " << counts[2]
+                   << " (" << 100.0_rt * static_cast<Real>(counts[1] + counts[2]) / static_cast<Real>(total)
+                   << "% iterated)" << std::endl;
+  }
+}
@@ -19,11 +19,14 @@ Castro::riemanncg(const Box& bx,
                   Array4<Real> const& qr,
                   Array4<Real const> const& qaux_arr,
                   Array4<Real> const& qint,
-                  const int idir) {
+                  const int idir,
+                  const Dim3* cells, const int ncells) {
 
   // this implements the approximate Riemann solver of Colella & Glaz
   // (1985)
   //
+  // if cells is not null, then we only solve on the ncells interfaces
+  // it lists (all of which are in bx) instead of the whole box
 
   constexpr Real weakwv = 1.e-3_rt;
 
@@ -87,8 +90,7 @@ Castro::riemanncg(const Box& bx,
   const Real lsmall_temp = small_temp;
   const Real lsmall = riemann_constants::small;
 
-  amrex::ParallelFor(bx,
-  [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+  auto cg_solve = [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
   {
 
 #ifndef AMREX_USE_GPU
@@ -560,7 +562,22 @@ Castro::riemanncg(const Box& bx,
       }
     }
 
-  });
+  };
+
+  if (cells == nullptr) {
+    amrex::ParallelFor(bx,
+    [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+    {
+      cg_solve(i, j, k);
+    });
+
+  } else {
+    amrex::ParallelFor(ncells,
+    [=] AMREX_GPU_HOST_DEVICE (int n)
+    {
+      cg_solve(cells[n].x, cells[n].y, cells[n].z);
+    });
+  }
 
 }
 
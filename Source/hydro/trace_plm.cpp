@@ -76,6 +76,8 @@ Castro::trace_plm(const Box& bx, const int idir,
   Real lsmall_dens = small_dens;
   Real lsmall_pres = small_pres;
 
+  const int split_passives = split_passive_advection;
+
   constexpr int NEIGN = 6;
   constexpr int IEIGN_RHO = 0;
   constexpr int IEIGN_UN = 1;
@@ -379,32 +381,38 @@ Castro::trace_plm(const Box& bx, const int idir,
     for (int ipassive = 0; ipassive < npassive; ipassive++) {
       int n = qpassmap(ipassive);
 
-      // get the slope
-
-      if (idir == 0) {
-        s[im2] = q_arr(i-2,j,k,n);
-        s[im1] = q_arr(i-1,j,k,n);
-        s[i0]  = q_arr(i,j,k,n);
-        s[ip1] = q_arr(i+1,j,k,n);
-        s[ip2] = q_arr(i+2,j,k,n);
-
-      } else if (idir == 1) {
-        s[im2] = q_arr(i,j-2,k,n);
-        s[im1] = q_arr(i,j-1,k,n);
-        s[i0]  = q_arr(i,j,k,n);
-        s[ip1] = q_arr(i,j+1,k,n);
-        s[ip2] = q_arr(i,j+2,k,n);
-
-      } else {
-        s[im2] = q_arr(i,j,k-2,n);
-        s[im1] = q_arr(i,j,k-1,n);
-        s[i0]  = q_arr(i,j,k,n);
-        s[ip1] = q_arr(i,j,k+1,n);
-        s[ip2] = q_arr(i,j,k+2,n);
+      // get the slope -- if the passives are advected separately
+      // after the Riemann solve (see passive_upwind_fluxes), we just use
+      // the zone average for the EOS calls on the interfaces
+
+      Real dX = 0.0_rt;
+
+      if (split_passives == 0) {
+        if (idir == 0) {
+          s[im2] = q_arr(i-2,j,k,n);
+          s[im1] = q_arr(i-1,j,k,n);
+          s[i0]  = q_arr(i,j,k,n);
+          s[ip1] = q_arr(i+1,j,k,n);
+          s[ip2] = q_arr(i+2,j,k,n);
+
+        } else if (idir == 1) {
+          s[im2] = q_arr(i,j-2,k,n);
+          s[im1] = q_arr(i,j-1,k,n);
+          s[i0]  = q_arr(i,j,k,n);
+          s[ip1] = q_arr(i,j+1,k,n);
+          s[ip2] = q_arr(i,j+2,k,n);
+
+        } else {
+          s[im2] = q_arr(i,j,k-2,n);
+          s[im1] = q_arr(i,j,k-1,n);
+          s[i0]  = q_arr(i,j,k,n);
+          s[ip1] = q_arr(i,j,k+1,n);
+          s[ip2] = q_arr(i,j,k+2,n);
+        }
+
+        dX = uslope(s, flat, false, false);
       }
 
-      Real dX = uslope(s, flat, false, false);
-
       // Right state
       if ((idir == 0 && i >= vlo[0]) ||
           (idir == 1 && j >= vlo[1]) ||
@@ -134,6 +134,8 @@ Castro::trace_ppm(const Box& bx,
   Real lsmall_dens = small_dens;
   Real lsmall_pres = small_pres;
 
+  const int split_passives = split_passive_advection;
+
   // Trace to left and right edges using upwind PPM
   amrex::ParallelFor(bx,
   [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
@@ -162,6 +164,15 @@ Castro::trace_ppm(const Box& bx,
     for (int n = 0; n < NQ; n++) {
       if (n == QTEMP) continue;
 
+      if (split_passives == 1 && n >= QFA && n < QFA + npassive) {
+        // the passives are advected separately after the Riemann solve
+        // (see passive_upwind_fluxes), so here they only need a
+        // reasonable edge value for the EOS calls -- use the zone average
+        Ip[n][1] = q_arr(i,j,k,n);
+        Im[n][1] = q_arr(i,j,k,n);
+        continue;
+      }
+
       if (idir == 0) {
         s[im2] = q_arr(i-2,j,k,n);
         s[im1] = q_arr(i-1,j,k,n);
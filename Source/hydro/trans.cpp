@@ -102,6 +102,7 @@ Castro::actual_trans_single(const Box& bx,
     bool reset_density = transverse_reset_density;
     bool reset_rhoe = transverse_reset_rhoe;
     Real small_p = small_pres;
+    int split_passives = split_passive_advection;
 
 #ifdef RADIATION
     int fspace_t = Radiation::fspace_advection_type;
@@ -163,6 +164,8 @@ Castro::actual_trans_single(const Box& bx,
 
         // Update all of the passively-advected quantities with the
         // transverse term and convert back to the primitive quantity.
+        // If they are advected separately after the hydro update, we
+        // just carry the normal predictor state along.
 
 #if AMREX_SPACEDIM == 2
         const Real volinv = 1.0_rt / vol(il,jl,kl);
@@ -171,6 +174,11 @@ Castro::actual_trans_single(const Box& bx,
             int n = upassmap(ipassive);
             int nqp = qpassmap(ipassive);
 
+            if (split_passives == 1) {
+                qo_arr(i,j,k,nqp) = q_arr(i,j,k,nqp);
+                continue;
+            }
+
 #if AMREX_SPACEDIM == 2
             Real rrnew = q_arr(i,j,k,QRHO) - hdt * (area_t(ir,jr,kr) * flux_t(ir,jr,kr,URHO) -
                                                 area_t(il,jl,kl) * flux_t(il,jl,kl,URHO)) * volinv;
@@ -508,6 +516,7 @@ Castro::actual_trans_final(const Box& bx,
     bool reset_density = transverse_reset_density;
     bool reset_rhoe = transverse_reset_rhoe;
     Real small_p = small_pres;
+    int split_passives = split_passive_advection;
 
 #ifdef RADIATION
     int fspace_t = Radiation::fspace_advection_type;
@@ -600,11 +609,18 @@ Castro::actual_trans_final(const Box& bx,
 
         // Update all of the passively-advected quantities with the
         // transverse terms and convert back to the primitive quantity.
+        // If they are advected separately after the hydro update, we
+        // just carry the state along.
 
         for (int ipassive = 0; ipassive < npassive; ++ipassive) {
             int n = upassmap(ipassive);
             int nqp = qpassmap(ipassive);
 
+            if (split_passives == 1) {
+                qo_arr(i,j,k,nqp) = q_arr(i,j,k,nqp);
+                continue;
+            }
+
             Real rrn = q_arr(i,j,k,QRHO);
             Real compn = rrn * q_arr(i,j,k,nqp);
             Real rrnewn = rrn - cdtdx_t1 * (flux_t1(ir_t1,jr_t1,kr_t1,URHO) -
@@ -6,6 +6,10 @@ using namespace amrex;
 void
 Castro::construct_ctu_mhd_source(Real time, Real dt)
 {
+      BL_PROFILE("Castro::construct_ctu_mhd_source()");
+
+      const Real strt_time = ParallelDescriptor::second();
+
       if (verbose && ParallelDescriptor::IOProcessor())
         std::cout << "... mhd ...!!! " << std::endl << std::endl;
 
@@ -29,9 +33,10 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
       BL_ASSERT(NUM_GROW == 6);
 
+      Long zones_advanced = 0;
 
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel reduction(+:zones_advanced)
 #endif
     {
 
@@ -74,10 +79,15 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
       FArrayBox div;
 
-      for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
+      // All of the temporaries below are sized relative to the tile, and
+      // each tile only writes the fluxes, electric fields, and magnetic
+      // fields on its own faces and edges, so we can tile this loop.
+      for (MFIter mfi(S_new, hydro_tile_size); mfi.isValid(); ++mfi)
         {
 
           const Box& bx = mfi.tilebox();
+
+          zones_advanced += bx.numPts();
           const Box& obx = amrex::grow(bx, 1);
           const Box& gbx = amrex::grow(bx, 2);
 
@@ -164,17 +174,11 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           auto qaux_arr = qaux.array();
           auto elix_qaux = qaux.elixir();
 
-          srcQ.resize(bx_gc, NQSRC);
-          auto src_q_arr = srcQ.array();
-          auto elix_src_q = srcQ.elixir();
-
           ctoprim(bx_gc, time,
                   u_arr,
                   Bx_arr, By_arr, Bz_arr,
                   q_arr, qaux_arr);
 
-          src_to_prim(bx_gc, q_arr, src_arr, src_q_arr);
-
           check_for_mhd_cfl_violation(bx, dt, q_arr, qaux_arr);
 
           // we need to compute the flattening coefficient for every zone
@@ -182,6 +186,14 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
           const Box& bxi = amrex::grow(bx, IntVect(3, 3, 3));
 
+          // the source terms are only needed in the zones we reconstruct
+
+          srcQ.resize(bxi, NQSRC);
+          auto src_q_arr = srcQ.array();
+          auto elix_src_q = srcQ.elixir();
+
+          src_to_prim(bxi, q_arr, src_arr, src_q_arr);
+
           flatn.resize(bxi, 1);
           auto flatn_arr = flatn.array();
           auto elix_flatn = flatn.elixir();
@@ -210,28 +222,36 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
           }
 
-          // Interpolate Cell centered values to faces
-          qleft[0].resize(bx_gc, NQ);
+          // Interpolate Cell centered values to faces.  The
+          // reconstruction is done on bxi, and the left state at the
+          // i+1/2 interface is stored in zone i+1, so the interface
+          // states only need one more zone on the high side of the
+          // reconstruction direction.
+          const Box& bxi_x = amrex::growHi(bxi, 0, 1);
+          const Box& bxi_y = amrex::growHi(bxi, 1, 1);
+          const Box& bxi_z = amrex::growHi(bxi, 2, 1);
+
+          qleft[0].resize(bxi_x, NQ);
           auto qx_left_arr = qleft[0].array();
           auto elix_qx_left = qleft[0].elixir();
 
-          qright[0].resize(bx_gc, NQ);
+          qright[0].resize(bxi_x, NQ);
           auto qx_right_arr = qright[0].array();
           auto elix_qx_right = qright[0].elixir();
 
-          qleft[1].resize(bx_gc, NQ);
+          qleft[1].resize(bxi_y, NQ);
           auto qy_left_arr = qleft[1].array();
           auto elix_qy_left = qleft[1].elixir();
 
-          qright[1].resize(bx_gc, NQ);
+          qright[1].resize(bxi_y, NQ);
           auto qy_right_arr = qright[1].array();
           auto elix_qy_right = qright[1].elixir();
 
-          qleft[2].resize(bx_gc, NQ);
+          qleft[2].resize(bxi_z, NQ);
           auto qz_left_arr = qleft[2].array();
           auto elix_qz_left = qleft[2].elixir();
 
-          qright[2].resize(bx_gc, NQ);
+          qright[2].resize(bxi_z, NQ);
           auto qz_right_arr = qright[2].array();
           auto elix_qz_right = qright[2].elixir();
 
@@ -632,11 +652,17 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
           consup_mhd(bx, update_arr, flxx_arr, flxy_arr, flxz_arr);
 
-          // magnetic update
+          // magnetic update -- neighboring tiles share the faces on
+          // their common boundary, so we only update the faces that
+          // belong to this tile
+
+          const Box& nbx_t = mfi.nodaltilebox(0);
+          const Box& nby_t = mfi.nodaltilebox(1);
+          const Box& nbz_t = mfi.nodaltilebox(2);
 
           Real dtdx = dt / dx[0];
 
-          amrex::ParallelFor(nbx,
+          amrex::ParallelFor(nbx_t,
           [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
           {
             Bxo_arr(i,j,k) = Bx_arr(i,j,k) + dtdx *
@@ -649,7 +675,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           dtdx = 0.0_rt;
 #endif
 
-          amrex::ParallelFor(nby,
+          amrex::ParallelFor(nby_t,
           [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
           {
             Byo_arr(i,j,k) = By_arr(i,j,k) + dtdx *
@@ -662,7 +688,7 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           dtdx = 0.0_rt;
 #endif
 
-          amrex::ParallelFor(nbz,
+          amrex::ParallelFor(nbz_t,
           [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
           {
             Bzo_arr(i,j,k) = Bz_arr(i,j,k) + dtdx *
@@ -719,5 +745,25 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
     }
 
+    if (verbose > 0)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+        ParallelDescriptor::ReduceLongSum(zones_advanced,IOProc);
+
+        if (ParallelDescriptor::IOProcessor()) {
+          std::cout << "Castro::construct_ctu_mhd_source() time = " << run_time << "\n";
+          std::cout << "    zones/sec = " << static_cast<Real>(zones_advanced) / run_time << "\n" << "\n";
+        }
+#ifdef BL_LAZY
+        });
+#endif
+    }
+
 }
 
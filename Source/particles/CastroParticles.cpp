@@ -2,6 +2,9 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <sstream>
+#include <fstream>
+#include <cstring>
 #include <Castro.H>
 #include <Castro_F.H>
 
@@ -251,6 +254,215 @@ Castro::TimestampParticles (int ngrow)
     }
 }
 
+void
+Castro::WriteParticleHistory ()
+{
+    BL_PROFILE("Castro::WriteParticleHistory()");
+
+    if (!TracerPC || particles::history_file.empty()) {
+        return;
+    }
+
+    // Figure out which species to record.
+
+    Vector<int> spec_comp;
+    Vector<std::string> spec_name;
+
+    {
+        std::istringstream is(particles::history_species);
+        std::string name;
+        while (is >> name) {
+            int n = 0;
+            for (; n < NumSpec; ++n) {
+                if (short_spec_names_cxx[n] == name) {
+                    break;
+                }
+            }
+            if (n == NumSpec) {
+                amrex::Error("particles.history_species: unknown species " + name);
+            }
+            spec_comp.push_back(UFS + n);
+            spec_name.push_back(name);
+        }
+    }
+
+    const int nspec_hist = spec_comp.size();
+
+    // Each record holds the particle id (Long) and cpu (int), followed
+    // by the time, the position, and then rho, T, e, and the selected
+    // mass fractions (all Real).
+
+    const int nreal = 1 + AMREX_SPACEDIM + 3 + nspec_hist;
+    const std::size_t record_size = sizeof(Long) + sizeof(int) + nreal * sizeof(Real);
+
+    // The layout is described once in a text header, written by the
+    // I/O processor.
+
+    static bool header_written = false;
+
+    if (!header_written && ParallelDescriptor::IOProcessor()) {
+        std::ofstream header(particles::history_file + ".header");
+        header << "record_size " << record_size << "\n";
+        header << "id Long\n";
+        header << "cpu int\n";
+        header << "time Real\n";
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            header << "x" << d << " Real\n";
+        }
+        header << "density Real\n";
+        header << "Temp Real\n";
+        header << "eint_e Real\n";
+        for (int n = 0; n < nspec_hist; ++n) {
+            header << "X(" << spec_name[n] << ") Real\n";
+        }
+    }
+
+    header_written = true;
+
+    Gpu::DeviceVector<int> spec_comp_d(nspec_hist);
+    Gpu::copy(Gpu::hostToDevice, spec_comp.begin(), spec_comp.end(), spec_comp_d.begin());
+    const int* spec_comp_p = spec_comp_d.dataPtr();
+
+    const Real time = state[State_Type].curTime();
+
+    Vector<char> records;
+
+    for (int lev = 0; lev <= parent->finestLevel(); ++lev)
+    {
+        if (TracerPC->NumberOfParticlesAtLevel(lev) <= 0) continue;
+
+        // We interpolate to the particle position the same way the
+        // tracers are advected, which needs one ghost cell.
+
+        MultiFab& S_new = parent->getLevel(lev).get_new_data(State_Type);
+        FillPatchIterator fpi(parent->getLevel(lev), S_new, 1, time, State_Type, 0, NUM_STATE);
+        const MultiFab& S = fpi.get_mf();
+
+        const Geometry& lev_geom = parent->Geom(lev);
+        const auto problo = lev_geom.ProbLoArray();
+        const auto dxinv = lev_geom.InvCellSizeArray();
+
+        using ParticleType = AmrTracerParticleContainer::ParticleType;
+
+        for (AmrTracerParticleContainer::ParConstIterType pti(*TracerPC, lev); pti.isValid(); ++pti)
+        {
+            const int np = pti.numParticles();
+            if (np == 0) continue;
+
+            const ParticleType* pstruct = pti.GetArrayOfStructs()().dataPtr();
+
+            auto u = S.const_array(pti);
+
+            Gpu::DeviceVector<Long> ids(np);
+            Gpu::DeviceVector<int> cpus(np);
+            Gpu::DeviceVector<Real> vals(np * nreal);
+
+            Long* ids_p = ids.dataPtr();
+            int* cpus_p = cpus.dataPtr();
+            Real* vals_p = vals.dataPtr();
+
+            amrex::ParallelFor(np,
+            [=] AMREX_GPU_HOST_DEVICE (int ip)
+            {
+                const ParticleType& p = pstruct[ip];
+
+                ids_p[ip] = p.id();
+                cpus_p[ip] = p.cpu();
+
+                Real* v = vals_p + ip * nreal;
+
+                // We record the state interpolated to the particle position
+                // with the cloud-in-cell (multilinear) weights that are used to
+                // interpolate the velocity when advecting the tracers.  The
+                // density and temperature are interpolated directly, while e
+                // and X are formed from the interpolated conserved quantities.
+
+                int idx[3] = {0, 0, 0};
+                Real w[3][2] = {{1.0_rt, 0.0_rt}, {1.0_rt, 0.0_rt}, {1.0_rt, 0.0_rt}};
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    const Real l = (p.pos(d) - problo[d]) * dxinv[d] - 0.5_rt;
+                    idx[d] = static_cast<int>(std::floor(l));
+                    w[d][1] = l - idx[d];
+                    w[d][0] = 1.0_rt - w[d][1];
+                }
+
+                const int mrho = 1 + AMREX_SPACEDIM;
+
+                for (int m = mrho; m < nreal; ++m) {
+                    v[m] = 0.0_rt;
+                }
+
+                for (int kk = 0; kk <= 1; ++kk) {
+                    for (int jj = 0; jj <= 1; ++jj) {
+                        for (int ii = 0; ii <= 1; ++ii) {
+                            const Real wt = w[0][ii] * w[1][jj] * w[2][kk];
+                            if (wt == 0.0_rt) continue;
+
+                            const int i = idx[0] + ii;
+                            const int j = idx[1] + jj;
+                            const int k = idx[2] + kk;
+
+                            int m = mrho;
+                            v[m++] += wt * u(i,j,k,URHO);
+                            v[m++] += wt * u(i,j,k,UTEMP);
+                            v[m++] += wt * u(i,j,k,UEINT);
+                            for (int n = 0; n < nspec_hist; ++n) {
+                                v[m++] += wt * u(i,j,k,spec_comp_p[n]);
+                            }
+                        }
+                    }
+                }
+
+                const Real rhoinv = 1.0_rt / v[mrho];
+
+                int m = 0;
+                v[m++] = time;
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    v[m++] = p.pos(d);
+                }
+                m += 2;
+                v[m++] *= rhoinv;
+                for (int n = 0; n < nspec_hist; ++n) {
+                    v[m++] *= rhoinv;
+                }
+            });
+
+            Vector<Long> ids_h(np);
+            Vector<int> cpus_h(np);
+            Vector<Real> vals_h(np * nreal);
+
+            Gpu::copy(Gpu::deviceToHost, ids.begin(), ids.end(), ids_h.begin());
+            Gpu::copy(Gpu::deviceToHost, cpus.begin(), cpus.end(), cpus_h.begin());
+            Gpu::copy(Gpu::deviceToHost, vals.begin(), vals.end(), vals_h.begin());
+
+            std::size_t offset = records.size();
+            records.resize(offset + np * record_size);
+
+            for (int ip = 0; ip < np; ++ip) {
+                char* r = records.dataPtr() + offset + ip * record_size;
+                std::memcpy(r, &ids_h[ip], sizeof(Long));
+                r += sizeof(Long);
+                std::memcpy(r, &cpus_h[ip], sizeof(int));
+                r += sizeof(int);
+                std::memcpy(r, &vals_h[ip * nreal], nreal * sizeof(Real));
+            }
+        }
+    }
+
+    // Each rank appends to its own file, so there is no communication.
+
+    if (!records.empty()) {
+        const std::string filename = amrex::Concatenate(particles::history_file + "_", ParallelDescriptor::MyProc(), 5);
+
+        std::ofstream history(filename, std::ios::out | std::ios::app | std::ios::binary);
+        if (!history.good()) {
+            amrex::FileOpenFailed(filename);
+        }
+
+        history.write(records.dataPtr(), records.size());
+    }
+}
+
 #endif
 
 void
@@ -258,6 +470,19 @@ Castro::advance_particles(int iteration, Real time, Real dt)
 {
     if (TracerPC)
     {
+        // The face-centered mass fluxes are only stored by the CTU-based
+        // integrators; for the others we always use the cell-centered velocity.
+        // If a retry subcycled this step, mass_fluxes only holds the flux of
+        // the last subcycle, so we also fall back in that case.
+
+        if (particles::advect_with_umac == 1 &&
+            (time_integration_method == CornerTransportUpwind ||
+             time_integration_method == SimplifiedSpectralDeferredCorrections) &&
+            sub_iteration <= 1) {
+            advect_particles_with_umac(iteration, dt);
+            return;
+        }
+
         int ng = iteration;
         Real t = time + 0.5*dt;
 
@@ -284,3 +509,138 @@ Castro::advance_particles(int iteration, Real time, Real dt)
         TracerPC->AdvectWithUcc(Ucc, level, dt);
     }
 }
+
+namespace {
+
+    // Copy the nearest valid value into each ghost cell.  Ghost cells
+    // that overlap another grid are overwritten by a subsequent
+    // FillBoundary.
+
+    void
+    fill_ghost_by_extrapolation (MultiFab& mf)
+    {
+        const int nc = mf.nComp();
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            const Box& vbx = mfi.validbox();
+            const Box& gbx = mfi.fabbox();
+
+            const auto vlo = amrex::lbound(vbx);
+            const auto vhi = amrex::ubound(vbx);
+
+            auto a = mf.array(mfi);
+
+            amrex::ParallelFor(gbx, nc,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, int n)
+            {
+                const int ii = amrex::min(amrex::max(i, vlo.x), vhi.x);
+                const int jj = amrex::min(amrex::max(j, vlo.y), vhi.y);
+                const int kk = amrex::min(amrex::max(k, vlo.z), vhi.z);
+
+                if (ii != i || jj != j || kk != k) {
+                    a(i,j,k,n) = a(ii,jj,kk,n);
+                }
+            });
+        }
+    }
+
+}
+
+
+void
+Castro::advect_particles_with_umac(int iteration, Real dt)
+{
+    BL_PROFILE("Castro::advect_particles_with_umac()");
+
+    // The hydro update stored the mass flux through each face,
+    // rho u A dt, in mass_fluxes.  Dividing by the time-centered
+    // face density gives the time-averaged face velocity, which is
+    // what the MAC-based particle push wants.
+
+    const MultiFab& S_old = get_old_data(State_Type);
+    const MultiFab& S_new = get_new_data(State_Type);
+
+    // The particles may have left the valid region during the subcycle,
+    // so we need iteration ghost cells (and at least one for the
+    // interpolation).
+
+    const int ng = amrex::max(1, iteration);
+
+    // Time-centered density, with one ghost cell for the face average.
+
+    MultiFab rho(grids, dmap, 1, 1);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(rho, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+        auto rho_arr = rho.array(mfi);
+        auto uold = S_old.const_array(mfi);
+        auto unew = S_new.const_array(mfi);
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+        {
+            rho_arr(i,j,k) = 0.5_rt * (uold(i,j,k,URHO) + unew(i,j,k,URHO));
+        });
+    }
+
+    // Where there is no neighboring grid (physical and coarse-fine
+    // boundaries), use the density of the interior zone.
+
+    fill_ghost_by_extrapolation(rho);
+    rho.FillBoundary(geom.periodicity());
+
+    Array<MultiFab, AMREX_SPACEDIM> umac;
+
+    for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+
+        umac[idir].define(getEdgeBoxArray(idir), dmap, 1, ng);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(umac[idir], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& nbx = mfi.tilebox();
+
+            auto u = umac[idir].array(mfi);
+            auto flux = mass_fluxes[idir]->const_array(mfi);
+            auto area_arr = area[idir].const_array(mfi);
+            auto rho_arr = rho.const_array(mfi);
+
+            amrex::ParallelFor(nbx,
+            [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+            {
+                const int il = (idir == 0) ? i-1 : i;
+                const int jl = (idir == 1) ? j-1 : j;
+                const int kl = (idir == 2) ? k-1 : k;
+
+                const Real rho_face = 0.5_rt * (rho_arr(il,jl,kl) + rho_arr(i,j,k));
+                const Real denom = rho_face * area_arr(i,j,k) * dt;
+
+                // The face area vanishes on the axis in curvilinear
+                // geometries, and there is no flow through it.
+
+                if (denom > 0.0_rt) {
+                    u(i,j,k) = flux(i,j,k) / denom;
+                } else {
+                    u(i,j,k) = 0.0_rt;
+                }
+            });
+        }
+
+        fill_ghost_by_extrapolation(umac[idir]);
+        umac[idir].FillBoundary(geom.periodicity());
+    }
+
+    TracerPC->AdvectWithUmac(umac.data(), level, dt);
+}
+
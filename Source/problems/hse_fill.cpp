@@ -6,6 +6,321 @@
 using namespace amrex;
 
 
+// Optionally, we cache the integrated ghost zone profiles (density,
+// temperature, and internal energy) for each column of a ghost cell
+// fill.  The cache is keyed by the state in the last two interior
+// zones of the column, and if that has changed by less than
+// castro.hse_cache_tol since the column was integrated, we reuse the
+// profile instead of redoing the Newton iterations and EOS calls.
+// The velocities are always recomputed from the current interior
+// state.
+//
+// There is one cache entry for each set of columns that is filled, so
+// the cache only holds the columns of this rank's boxes.  A fill holds
+// its entry for as long as it runs, so fills running at the same time
+// never share one; if the entry is already taken, the fill is done
+// without the cache.  The cache holds up to hse_cache_ngrow ghost
+// zones in depth, and deeper fills are done without it.  The entries
+// are freed when the grids change.
+
+namespace {
+
+    constexpr int hse_cache_ngrow = 8;
+    constexpr int hse_cache_nkey = 3 + NumSpec + NumAux;
+
+    struct HSECacheView
+    {
+        Real* key = nullptr;
+        Real* prof = nullptr;
+        int* depth = nullptr;
+        unsigned long long* counts = nullptr;
+        int lo0 = 0;
+        int lo1 = 0;
+        int len0 = 0;
+        int len1 = 0;
+        Real tol = 0.0_rt;
+        bool active = false;
+
+        // the cache index of the column at transverse zone (a, b), or
+        // -1 if it is not cached
+
+        AMREX_GPU_HOST_DEVICE
+        int column (int a, int b) const
+        {
+            const int ia = a - lo0;
+            const int ib = b - lo1;
+            if (!active || ia < 0 || ia >= len0 || ib < 0 || ib >= len1) {
+                return -1;
+            }
+            return ia + len0 * ib;
+        }
+
+        // is there a valid profile at least ndepth zones deep for this
+        // column, integrated from a state within tol of k?  On a miss,
+        // the old profile is invalidated, since we will overwrite it.
+
+        AMREX_GPU_HOST_DEVICE
+        bool lookup (int col, const Real* k, int ndepth) const
+        {
+            if (col < 0) {
+                return false;
+            }
+
+            bool hit = depth[col] >= ndepth;
+
+            if (hit) {
+                const Real* kc = key + col * hse_cache_nkey;
+
+                // density and temperatures are compared relative,
+                // the composition absolute
+
+                for (int n = 0; n < 3; ++n) {
+                    if (std::abs(k[n] - kc[n]) > tol * std::abs(kc[n])) {
+                        hit = false;
+                    }
+                }
+                for (int n = 3; n < hse_cache_nkey; ++n) {
+                    if (std::abs(k[n] - kc[n]) > tol) {
+                        hit = false;
+                    }
+                }
+            }
+
+            if (hit) {
+                Gpu::Atomic::Add(&counts[0], 1ULL);
+            } else {
+                Gpu::Atomic::Add(&counts[1], 1ULL);
+                depth[col] = 0;
+            }
+
+            return hit;
+        }
+
+        AMREX_GPU_HOST_DEVICE
+        Real dens (int col, int id) const { return prof[3 * (col * hse_cache_ngrow + id)]; }
+
+        AMREX_GPU_HOST_DEVICE
+        Real temp (int col, int id) const { return prof[3 * (col * hse_cache_ngrow + id) + 1]; }
+
+        AMREX_GPU_HOST_DEVICE
+        Real eint (int col, int id) const { return prof[3 * (col * hse_cache_ngrow + id) + 2]; }
+
+        AMREX_GPU_HOST_DEVICE
+        void store (int col, int id, Real dens_zone, Real temp_zone, Real eint_zone) const
+        {
+            if (col < 0 || id >= hse_cache_ngrow) {
+                return;
+            }
+            Real* p = prof + 3 * (col * hse_cache_ngrow + id);
+            p[0] = dens_zone;
+            p[1] = temp_zone;
+            p[2] = eint_zone;
+        }
+
+        // mark the column's profile as valid once all of its zones are stored
+
+        AMREX_GPU_HOST_DEVICE
+        void store_key (int col, const Real* k, int ndepth) const
+        {
+            if (col < 0 || ndepth > hse_cache_ngrow) {
+                return;
+            }
+            Real* kc = key + col * hse_cache_nkey;
+            for (int n = 0; n < hse_cache_nkey; ++n) {
+                kc[n] = k[n];
+            }
+            depth[col] = ndepth;
+        }
+    };
+
+    struct HSECacheEntry
+    {
+        Box domain;
+        int face;
+        int lo0, lo1, len0, len1;
+        bool in_use = false;
+        Gpu::DeviceVector<Real> key;
+        Gpu::DeviceVector<Real> prof;
+        Gpu::DeviceVector<int> depth;
+        Gpu::DeviceVector<unsigned long long> counts;
+    };
+
+    Vector<std::unique_ptr<HSECacheEntry>> hse_cache_entries;
+    bool hse_cache_finalize_added = false;
+
+    // Holds the cache entry for the columns of the fill gbx on face
+    // (idir, side) of the domain of geom for as long as the fill runs,
+    // creating the entry if needed.  The view is inactive if caching is
+    // disabled, the fill is too deep, or another fill holds the entry.
+
+    class HSECacheFill
+    {
+    public:
+
+        HSECacheFill (const Geometry& geom, int idir, int side, const Box& gbx, int ndepth)
+        {
+            if (castro::hse_cache == 0 || ndepth > hse_cache_ngrow) {
+                return;
+            }
+
+            const Box& domain = geom.Domain();
+            const int face = 2 * idir + side;
+
+            // the two transverse directions
+
+            int tdir[2];
+            int nt = 0;
+            for (int d = 0; d < 3; ++d) {
+                if (d != idir) {
+                    tdir[nt++] = d;
+                }
+            }
+
+            int tlo[2];
+            int tlen[2];
+            for (int t = 0; t < 2; ++t) {
+                if (tdir[t] < AMREX_SPACEDIM) {
+                    tlo[t] = gbx.smallEnd(tdir[t]);
+                    tlen[t] = gbx.length(tdir[t]);
+                } else {
+                    tlo[t] = 0;
+                    tlen[t] = 1;
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp critical (hse_cache)
+#endif
+            {
+                if (!hse_cache_finalize_added) {
+                    amrex::ExecOnFinalize([] () {
+                        hse_cache_entries.clear();
+                    });
+                    hse_cache_finalize_added = true;
+                }
+
+                HSECacheEntry* entry = nullptr;
+
+                for (auto& c : hse_cache_entries) {
+                    if (c->face == face && c->domain == domain &&
+                        c->lo0 == tlo[0] && c->lo1 == tlo[1] &&
+                        c->len0 == tlen[0] && c->len1 == tlen[1]) {
+                        entry = c.get();
+                    }
+                }
+
+                if (entry == nullptr) {
+                    hse_cache_entries.emplace_back(new HSECacheEntry);
+                    entry = hse_cache_entries.back().get();
+
+                    entry->domain = domain;
+                    entry->face = face;
+                    entry->lo0 = tlo[0];
+                    entry->lo1 = tlo[1];
+                    entry->len0 = tlen[0];
+                    entry->len1 = tlen[1];
+
+                    const int ncol = tlen[0] * tlen[1];
+
+                    entry->key.resize(ncol * hse_cache_nkey);
+                    entry->prof.resize(ncol * hse_cache_ngrow * 3);
+                    entry->depth.resize(ncol, 0);
+                    entry->counts.resize(2, 0ULL);
+                }
+
+                if (!entry->in_use) {
+                    entry->in_use = true;
+                    m_entry = entry;
+                }
+            }
+
+            if (m_entry == nullptr) {
+                return;
+            }
+
+            m_view.key = m_entry->key.dataPtr();
+            m_view.prof = m_entry->prof.dataPtr();
+            m_view.depth = m_entry->depth.dataPtr();
+            m_view.counts = m_entry->counts.dataPtr();
+            m_view.lo0 = m_entry->lo0;
+            m_view.lo1 = m_entry->lo1;
+            m_view.len0 = m_entry->len0;
+            m_view.len1 = m_entry->len1;
+            m_view.tol = castro::hse_cache_tol;
+            m_view.active = true;
+        }
+
+        ~HSECacheFill ()
+        {
+            if (m_entry == nullptr) {
+                return;
+            }
+
+            // the fill may still be running on the GPU
+
+            Gpu::streamSynchronize();
+
+#ifdef _OPENMP
+#pragma omp critical (hse_cache)
+#endif
+            {
+                m_entry->in_use = false;
+            }
+        }
+
+        HSECacheFill (const HSECacheFill&) = delete;
+        HSECacheFill& operator= (const HSECacheFill&) = delete;
+
+        const HSECacheView& view () const { return m_view; }
+
+    private:
+
+        HSECacheEntry* m_entry = nullptr;
+        HSECacheView m_view;
+    };
+
+}
+
+
+void
+print_hse_cache_stats ()
+{
+    Long stats[2] = {0, 0};
+
+    for (auto& c : hse_cache_entries) {
+        unsigned long long counts[2];
+        Gpu::copy(Gpu::deviceToHost, c->counts.begin(), c->counts.end(), counts);
+
+        stats[0] += static_cast<Long>(counts[0]);
+        stats[1] += static_cast<Long>(counts[1]);
+
+        // reset the counters
+
+        counts[0] = 0ULL;
+        counts[1] = 0ULL;
+        Gpu::copy(Gpu::hostToDevice, counts, counts + 2, c->counts.begin());
+    }
+
+    ParallelDescriptor::ReduceLongSum(stats, 2);
+
+    const Long total = stats[0] + stats[1];
+
+    if (total > 0) {
+        amrex::Print() << "... HSE boundary cache: " << stats[0] << " hits, "
+                       << stats[1] << " misses ("
+                       << 100.0_rt * static_cast<Real>(stats[0]) / static_cast<Real>(total)
+                       << "% hit rate)" << std::endl;
+    }
+}
+
+
+void
+clear_hse_cache ()
+{
+    hse_cache_entries.clear();
+}
+
+
 // a hydrostatic boundary conditions -- this relies on the assumption
 // that the gravitation acceleration is constant
 
@@ -48,6 +363,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(domlo[0]-1, lo[1], lo[2])),
                     IntVect(D_DECL(domlo[0]-1, hi[1], hi[2])));
 
+            const int ndepth = domlo[0] - adv_lo[0];
+
+            const HSECacheFill cache_fill(geom, 0, 0, gbx, ndepth);
+            const auto cache = cache_fill.view();
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
             {
@@ -65,6 +385,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
+                // have we already integrated this column from
+                // (nearly) the same interior state?
+
+                Real key[hse_cache_nkey];
+                key[0] = dens_above;
+                key[1] = temp_above;
+                key[2] = adv(domlo[0]+1,j,k,UTEMP);
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
+
+                const int col = cache.column(j, k);
+                const bool cache_hit = cache.lookup(col, key, ndepth);
+
                 //  keep track of the density at the base of the domain
 
                 Real dens_base = dens_above;
@@ -83,9 +422,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
-
-                Real pres_above = eos_state.p;
+                Real pres_above = 0.0_rt;
+                if (!cache_hit) {
+                    eos(eos_input_rt, eos_state);
+                    pres_above = eos_state.p;
+                }
 
                 for (int ii = domlo[0]-1; ii >= adv_lo[0]; ii--) {
 
@@ -107,60 +448,85 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_above;
                     }
 
-                    bool converged_hse = false;
+                    Real eint;
+                    Real pres_zone = 0.0_rt;
 
-                    Real p_want;
-                    Real drho;
+                    const int id = domlo[0]-1-ii;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    if (cache_hit) {
 
-                        // pressure needed from HSE
+                        dens_zone = cache.dens(col, id);
+                        temp_zone = cache.temp(col, id);
+                        eint = cache.eint(col, id);
 
-                        p_want = pres_above -
-                            dx[0] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
+                    } else {
 
-                        // pressure from EOS
+                        bool converged_hse = false;
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                        Real p_want;
+                        Real drho;
 
-                        eos(eos_input_rt, eos_state);
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                            // pressure needed from HSE
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr + 0.5_rt * dx[0] * gravity::const_grav);
+                            p_want = pres_above -
+                                dx[0] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            // pressure from EOS
 
-                        // convergence?
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            eos(eos_input_rt, eos_state);
 
-                    }
+                            pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
+
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr + 0.5_rt * dx[0] * gravity::const_grav);
+
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+
+                            // convergence?
+
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
+
+                        }
 
 #ifndef AMREX_USE_CUDA
-                    if (! converged_hse) {
-                        std::cout << "ii, j, k, domlo[0]: " << ii << " " << j << " " << k << " " << domlo[0] << std::endl;
-                        std::cout << "p_want:    " << p_want << std::endl;
-                        std::cout << "dens_zone: " << dens_zone << std::endl;
-                        std::cout << "temp_zone: " << temp_zone << std::endl;
-                        std::cout << "drho:      " << drho << std::endl;
-                        std::cout << std::endl;
-                        std::cout << "column info: " << std::endl;
-                        std::cout << "   dens: " << adv(ii,j,k,URHO) << std::endl;
-                        std::cout << "   temp: " << adv(ii,j,k,UTEMP) << std::endl;
-                        amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -X BC");
-                   }
+                        if (! converged_hse) {
+                            std::cout << "ii, j, k, domlo[0]: " << ii << " " << j << " " << k << " " << domlo[0] << std::endl;
+                            std::cout << "p_want:    " << p_want << std::endl;
+                            std::cout << "dens_zone: " << dens_zone << std::endl;
+                            std::cout << "temp_zone: " << temp_zone << std::endl;
+                            std::cout << "drho:      " << drho << std::endl;
+                            std::cout << std::endl;
+                            std::cout << "column info: " << std::endl;
+                            std::cout << "   dens: " << adv(ii,j,k,URHO) << std::endl;
+                            std::cout << "   temp: " << adv(ii,j,k,UTEMP) << std::endl;
+                            amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -X BC");
+                       }
 #endif
 
+                        eos_state.rho = dens_zone;
+                        eos_state.T = temp_zone;
+
+                        eos(eos_input_rt, eos_state);
+
+                        pres_zone = eos_state.p;
+                        eint = eos_state.e;
+
+                        cache.store(col, id, dens_zone, temp_zone, eint);
+
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -190,14 +556,6 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                       }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
-
-                   eos(eos_input_rt, eos_state);
-
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
-
                    // store the final state
 
                    adv(ii,j,k,URHO) = dens_zone;
@@ -222,6 +580,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_above = pres_zone;
 
                 }
+
+                if (!cache_hit) {
+                    cache.store_key(col, key, ndepth);
+                }
             });
 
         }
@@ -238,6 +600,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(domhi[0]+1, lo[1], lo[2])),
                     IntVect(D_DECL(domhi[0]+1, hi[1], hi[2])));
 
+            const int ndepth = adv_hi[0] - domhi[0];
+
+            const HSECacheFill cache_fill(geom, 0, 1, gbx, ndepth);
+            const auto cache = cache_fill.view();
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
             {
@@ -255,6 +622,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
+                // have we already integrated this column from
+                // (nearly) the same interior state?
+
+                Real key[hse_cache_nkey];
+                key[0] = dens_below;
+                key[1] = temp_below;
+                key[2] = adv(domhi[0]-1,j,k,UTEMP);
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
+
+                const int col = cache.column(j, k);
+                const bool cache_hit = cache.lookup(col, key, ndepth);
+
                 // keep track of the density at the top of the domain
 
                 Real dens_base = dens_below;
@@ -273,9 +659,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
-
-                Real pres_below = eos_state.p;
+                Real pres_below = 0.0_rt;
+                if (!cache_hit) {
+                    eos(eos_input_rt, eos_state);
+                    pres_below = eos_state.p;
+                }
 
                 for (int ii = domhi[0]+1; ii <= adv_hi[0]; ii++) {
 
@@ -293,59 +681,84 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_below;
                     }
 
-                    bool converged_hse = false;
+                    Real eint;
+                    Real pres_zone = 0.0_rt;
 
-                    Real p_want;
-                    Real drho;
+                    const int id = ii-domhi[0]-1;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    if (cache_hit) {
 
-                        // pressure needed from HSE
-                        p_want = pres_below +
-                            dx[0] * 0.5_rt * (dens_zone + dens_below) * gravity::const_grav;
+                        dens_zone = cache.dens(col, id);
+                        temp_zone = cache.temp(col, id);
+                        eint = cache.eint(col, id);
 
-                        // pressure from EOS
+                    } else {
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                        bool converged_hse = false;
 
-                        eos(eos_input_rt, eos_state);
+                        Real p_want;
+                        Real drho;
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr - 0.5_rt * dx[0] * gravity::const_grav);
+                            // pressure needed from HSE
+                            p_want = pres_below +
+                                dx[0] * 0.5_rt * (dens_zone + dens_below) * gravity::const_grav;
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            // pressure from EOS
 
-                        // convergence?
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            eos(eos_input_rt, eos_state);
 
-                    }
+                            pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
+
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr - 0.5_rt * dx[0] * gravity::const_grav);
+
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+
+                            // convergence?
+
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
+
+                        }
 
 #ifndef AMREX_USE_CUDA
-                   if (! converged_hse) {
-                       std::cout << "ii, j, k, domhi[0]: " << ii << " " << j << " " << k << " " << domhi[0] << std::endl;
-                       std::cout << "p_want:    " << p_want << std::endl;
-                       std::cout << "dens_zone: " << dens_zone << std::endl;
-                       std::cout << "temp_zone: " << temp_zone << std::endl;
-                       std::cout << "drho:      " << drho << std::endl;
-                       std::cout << std::endl;
-                       std::cout << "column info: " << std::endl;
-                       std::cout << "   dens: " << adv(ii,j,k,URHO) << std::endl;
-                       std::cout << "   temp: " << adv(ii,j,k,UTEMP) << std::endl;
-                       amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in +X BC");
-                   }
+                       if (! converged_hse) {
+                           std::cout << "ii, j, k, domhi[0]: " << ii << " " << j << " " << k << " " << domhi[0] << std::endl;
+                           std::cout << "p_want:    " << p_want << std::endl;
+                           std::cout << "dens_zone: " << dens_zone << std::endl;
+                           std::cout << "temp_zone: " << temp_zone << std::endl;
+                           std::cout << "drho:      " << drho << std::endl;
+                           std::cout << std::endl;
+                           std::cout << "column info: " << std::endl;
+                           std::cout << "   dens: " << adv(ii,j,k,URHO) << std::endl;
+                           std::cout << "   temp: " << adv(ii,j,k,UTEMP) << std::endl;
+                           amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in +X BC");
+                       }
 #endif
 
+                        eos_state.rho = dens_zone;
+                        eos_state.T = temp_zone;
+
+                        eos(eos_input_rt, eos_state);
+
+                        pres_zone = eos_state.p;
+                        eint = eos_state.e;
+
+                        cache.store(col, id, dens_zone, temp_zone, eint);
+
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -375,14 +788,6 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
-
-                   eos(eos_input_rt, eos_state);
-
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
-
                    //  store the final state
 
                    adv(ii,j,k,URHO) = dens_zone;
@@ -407,6 +812,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_below = pres_zone;
 
                 }
+
+                if (!cache_hit) {
+                    cache.store_key(col, key, ndepth);
+                }
             });
 
        }
@@ -428,6 +837,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(lo[0], domlo[1]-1, lo[2])),
                     IntVect(D_DECL(hi[0], domlo[1]-1, hi[2])));
 
+            const int ndepth = domlo[1] - adv_lo[1];
+
+            const HSECacheFill cache_fill(geom, 1, 0, gbx, ndepth);
+            const auto cache = cache_fill.view();
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
             {
@@ -445,6 +859,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
+                // have we already integrated this column from
+                // (nearly) the same interior state?
+
+                Real key[hse_cache_nkey];
+                key[0] = dens_above;
+                key[1] = temp_above;
+                key[2] = adv(i,domlo[1]+1,k,UTEMP);
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
+
+                const int col = cache.column(i, k);
+                const bool cache_hit = cache.lookup(col, key, ndepth);
+
                 // keep track of the density at the base of the domain
 
                 Real dens_base = dens_above;
@@ -463,9 +896,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
-
-                Real pres_above = eos_state.p;
+                Real pres_above = 0.0_rt;
+                if (!cache_hit) {
+                    eos(eos_input_rt, eos_state);
+                    pres_above = eos_state.p;
+                }
 
                 for (int jj = domlo[1]-1; jj >= adv_lo[1]; jj--) {
 
@@ -484,60 +919,85 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_above;
                     }
 
-                    bool converged_hse = false;
+                    Real eint;
+                    Real pres_zone = 0.0_rt;
 
-                    Real p_want;
-                    Real drho;
+                    const int id = domlo[1]-1-jj;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    if (cache_hit) {
 
-                        // pressure needed from HSE
+                        dens_zone = cache.dens(col, id);
+                        temp_zone = cache.temp(col, id);
+                        eint = cache.eint(col, id);
 
-                        p_want = pres_above -
-                            dx[1] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
+                    } else {
 
-                        // pressure from EOS
+                        bool converged_hse = false;
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                        Real p_want;
+                        Real drho;
 
-                        eos(eos_input_rt, eos_state);
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                            // pressure needed from HSE
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr + 0.5_rt * dx[1] * gravity::const_grav);
+                            p_want = pres_above -
+                                dx[1] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            // pressure from EOS
 
-                        // convergence?
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            eos(eos_input_rt, eos_state);
 
-                    }
+                            pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
+
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr + 0.5_rt * dx[1] * gravity::const_grav);
+
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+
+                            // convergence?
+
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
+
+                        }
 
 #ifndef AMREX_USE_CUDA
-                   if (! converged_hse) {
-                       std::cout << "i, jj, k, domlo[1]: " << i << " " << jj << " " << k << " " << domlo[1] << std::endl;
-                       std::cout << "p_want:    " << p_want << std::endl;
-                       std::cout << "dens_zone: " << dens_zone << std::endl;
-                       std::cout << "temp_zone: " << temp_zone << std::endl;
-                       std::cout << "drho:      " << drho << std::endl;
-                       std::cout << std::endl;
-                       std::cout << "column info: " << std::endl;
-                       std::cout << "   dens: " << adv(i,jj,k,URHO) << std::endl;
-                       std::cout << "   temp: " << adv(i,jj,k,UTEMP) << std::endl;
-                       amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -Y BC");
-                   }
+                       if (! converged_hse) {
+                           std::cout << "i, jj, k, domlo[1]: " << i << " " << jj << " " << k << " " << domlo[1] << std::endl;
+                           std::cout << "p_want:    " << p_want << std::endl;
+                           std::cout << "dens_zone: " << dens_zone << std::endl;
+                           std::cout << "temp_zone: " << temp_zone << std::endl;
+                           std::cout << "drho:      " << drho << std::endl;
+                           std::cout << std::endl;
+                           std::cout << "column info: " << std::endl;
+                           std::cout << "   dens: " << adv(i,jj,k,URHO) << std::endl;
+                           std::cout << "   temp: " << adv(i,jj,k,UTEMP) << std::endl;
+                           amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -Y BC");
+                       }
 #endif
 
+                        eos_state.rho = dens_zone;
+                        eos_state.T = temp_zone;
+
+                        eos(eos_input_rt, eos_state);
+
+                        pres_zone = eos_state.p;
+                        eint = eos_state.e;
+
+                        cache.store(col, id, dens_zone, temp_zone, eint);
+
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -567,14 +1027,6 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
-
-                   eos(eos_input_rt, eos_state);
-
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
-
                    // store the final state
 
                    adv(i,jj,k,URHO) = dens_zone;
@@ -599,6 +1051,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_above = pres_zone;
 
                 }
+
+                if (!cache_hit) {
+                    cache.store_key(col, key, ndepth);
+                }
             });
 
        }
@@ -616,6 +1072,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(lo[0], domhi[1]+1, lo[2])),
                     IntVect(D_DECL(hi[0], domhi[1]+1, hi[2])));
 
+            const int ndepth = adv_hi[1] - domhi[1];
+
+            const HSECacheFill cache_fill(geom, 1, 1, gbx, ndepth);
+            const auto cache = cache_fill.view();
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
             {
@@ -633,6 +1094,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
+                // have we already integrated this column from
+                // (nearly) the same interior state?
+
+                Real key[hse_cache_nkey];
+                key[0] = dens_below;
+                key[1] = temp_below;
+                key[2] = adv(i,domhi[1]-1,k,UTEMP);
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
+
+                const int col = cache.column(i, k);
+                const bool cache_hit = cache.lookup(col, key, ndepth);
+
                 // keep track of the density at the base of the domain
 
                 Real dens_base = dens_below;
@@ -651,9 +1131,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
-
-                Real pres_below = eos_state.p;
+                Real pres_below = 0.0_rt;
+                if (!cache_hit) {
+                    eos(eos_input_rt, eos_state);
+                    pres_below = eos_state.p;
+                }
 
                 for (int jj = domhi[1]+1; jj <= adv_hi[1]; jj++) {
 
@@ -671,59 +1153,84 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_below;
                     }
 
-                    bool converged_hse = false;
+                    Real eint;
+                    Real pres_zone = 0.0_rt;
 
-                    Real p_want;
-                    Real drho;
+                    const int id = jj-domhi[1]-1;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    if (cache_hit) {
 
-                        // pressure needed from HSE
-                        p_want = pres_below +
-                            dx[1] * 0.5_rt * (dens_zone + dens_below) * gravity::const_grav;
+                        dens_zone = cache.dens(col, id);
+                        temp_zone = cache.temp(col, id);
+                        eint = cache.eint(col, id);
 
-                        // pressure from EOS
+                    } else {
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                        bool converged_hse = false;
 
-                        eos(eos_input_rt, eos_state);
+                        Real p_want;
+                        Real drho;
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr - 0.5_rt * dx[1] * gravity::const_grav);
+                            // pressure needed from HSE
+                            p_want = pres_below +
+                                dx[1] * 0.5_rt * (dens_zone + dens_below) * gravity::const_grav;
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            // pressure from EOS
 
-                        // convergence?
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            eos(eos_input_rt, eos_state);
 
-                    }
+                            pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
+
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr - 0.5_rt * dx[1] * gravity::const_grav);
+
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+
+                            // convergence?
+
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
+
+                        }
 
 #ifndef AMREX_USE_CUDA
-                   if (! converged_hse) {
-                       std::cout << "i, jj, k, domhi[1]: " << i << " " << jj << " " << k << " " << domhi[1] << std::endl;
-                       std::cout << "p_want:    " << p_want << std::endl;
-                       std::cout << "dens_zone: " << dens_zone << std::endl;
-                       std::cout << "temp_zone: " << temp_zone << std::endl;
-                       std::cout << "drho:      " << drho << std::endl;
-                       std::cout << std::endl;
-                       std::cout << "column info: " << std::endl;
-                       std::cout << "   dens: " << adv(i,jj,k,URHO) << std::endl;
-                       std::cout << "   temp: " << adv(i,jj,k,UTEMP) << std::endl;
-                       amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in +Y BC");
-                   }
+                       if (! converged_hse) {
+                           std::cout << "i, jj, k, domhi[1]: " << i << " " << jj << " " << k << " " << domhi[1] << std::endl;
+                           std::cout << "p_want:    " << p_want << std::endl;
+                           std::cout << "dens_zone: " << dens_zone << std::endl;
+                           std::cout << "temp_zone: " << temp_zone << std::endl;
+                           std::cout << "drho:      " << drho << std::endl;
+                           std::cout << std::endl;
+                           std::cout << "column info: " << std::endl;
+                           std::cout << "   dens: " << adv(i,jj,k,URHO) << std::endl;
+                           std::cout << "   temp: " << adv(i,jj,k,UTEMP) << std::endl;
+                           amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in +Y BC");
+                       }
 #endif
 
+                        eos_state.rho = dens_zone;
+                        eos_state.T = temp_zone;
+
+                        eos(eos_input_rt, eos_state);
+
+                        pres_zone = eos_state.p;
+                        eint = eos_state.e;
+
+                        cache.store(col, id, dens_zone, temp_zone, eint);
+
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -753,14 +1260,6 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
-
-                   eos(eos_input_rt, eos_state);
-
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
-
                    // store the final state
 
                    adv(i,jj,k,URHO) = dens_zone;
@@ -785,6 +1284,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_below = pres_zone;
 
                 }
+
+                if (!cache_hit) {
+                    cache.store_key(col, key, ndepth);
+                }
             });
         }
 
@@ -805,6 +1308,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(D_DECL(lo[0], lo[1], domlo[2]-1)),
                     IntVect(D_DECL(hi[0], hi[1], domlo[2]-1)));
 
+            const int ndepth = domlo[2] - adv_lo[2];
+
+            const HSECacheFill cache_fill(geom, 2, 0, gbx, ndepth);
+            const auto cache = cache_fill.view();
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
             {
@@ -822,6 +1330,25 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
+                // have we already integrated this column from
+                // (nearly) the same interior state?
+
+                Real key[hse_cache_nkey];
+                key[0] = dens_above;
+                key[1] = temp_above;
+                key[2] = adv(i,j,domlo[2]+1,UTEMP);
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
+
+                const int col = cache.column(i, j);
+                const bool cache_hit = cache.lookup(col, key, ndepth);
+
                 // keep track of the density at the base of the domain
 
                 Real dens_base = dens_above;
@@ -840,9 +1367,11 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                 }
 #endif
 
-                eos(eos_input_rt, eos_state);
-
-                Real pres_above = eos_state.p;
+                Real pres_above = 0.0_rt;
+                if (!cache_hit) {
+                    eos(eos_input_rt, eos_state);
+                    pres_above = eos_state.p;
+                }
 
                 for (int kk = domlo[2]-1; kk >= adv_lo[2]; kk--) {
 
@@ -861,60 +1390,85 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                         temp_zone = temp_above;
                     }
 
-                    bool converged_hse = false;
+                    Real eint;
+                    Real pres_zone = 0.0_rt;
 
-                    Real p_want;
-                    Real drho;
+                    const int id = domlo[2]-1-kk;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                    if (cache_hit) {
 
-                        // pressure needed from HSE
+                        dens_zone = cache.dens(col, id);
+                        temp_zone = cache.temp(col, id);
+                        eint = cache.eint(col, id);
 
-                        p_want = pres_above -
-                            dx[2] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
+                    } else {
 
-                        // pressure from EOS
+                        bool converged_hse = false;
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                        Real p_want;
+                        Real drho;
 
-                        eos(eos_input_rt, eos_state);
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                            // pressure needed from HSE
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr + 0.5_rt * dx[2] * gravity::const_grav);
+                            p_want = pres_above -
+                                dx[2] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            // pressure from EOS
 
-                        // convergence?
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            eos(eos_input_rt, eos_state);
 
-                    }
+                            pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
+
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr + 0.5_rt * dx[2] * gravity::const_grav);
+
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+
+                            // convergence?
+
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
+
+                        }
 
 #ifndef AMREX_USE_CUDA
-                   if (! converged_hse) {
-                       std::cout << "i, j, kk, domlo[2]: " << i << " " << j << " " << kk << " " << domlo[2] << std::endl;
-                       std::cout << "p_want:    " << p_want << std::endl;
-                       std::cout << "dens_zone: " << dens_zone << std::endl;
-                       std::cout << "temp_zone: " << temp_zone << std::endl;
-                       std::cout << "drho:      " << drho << std::endl;
-                       std::cout << std::endl;
-                       std::cout << "column info: " << std::endl;
-                       std::cout << "   dens: " << adv(i,j,kk,URHO) << std::endl;
-                       std::cout << "   temp: " << adv(i,j,kk,UTEMP) << std::endl;
-                       amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -Z BC");
-                   }
+                       if (! converged_hse) {
+                           std::cout << "i, j, kk, domlo[2]: " << i << " " << j << " " << kk << " " << domlo[2] << std::endl;
+                           std::cout << "p_want:    " << p_want << std::endl;
+                           std::cout << "dens_zone: " << dens_zone << std::endl;
+                           std::cout << "temp_zone: " << temp_zone << std::endl;
+                           std::cout << "drho:      " << drho << std::endl;
+                           std::cout << std::endl;
+                           std::cout << "column info: " << std::endl;
+                           std::cout << "   dens: " << adv(i,j,kk,URHO) << std::endl;
+                           std::cout << "   temp: " << adv(i,j,kk,UTEMP) << std::endl;
+                           amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -Z BC");
+                       }
 #endif
 
+                        eos_state.rho = dens_zone;
+                        eos_state.T = temp_zone;
+
+                        eos(eos_input_rt, eos_state);
+
+                        pres_zone = eos_state.p;
+                        eint = eos_state.e;
+
+                        cache.store(col, id, dens_zone, temp_zone, eint);
+
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -944,14 +1498,6 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
-
-                   eos(eos_input_rt, eos_state);
-
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
-
                    // store the final state
 
                    adv(i,j,kk,URHO) = dens_zone;
@@ -976,6 +1522,10 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_above = pres_zone;
 
                 }
+
+                if (!cache_hit) {
+                    cache.store_key(col, key, ndepth);
+                }
             });
         }
 
@@ -21,6 +21,25 @@ static int ispow2(int i)
   return (i == 1) ? 1 : (((i <= 0) || (i & 1)) ? 0 : ispow2(i / 2));
 }
 
+// Maximum relative difference between two sets of coefficients,
+// used to decide whether an existing solver setup can be reused.
+
+static Real relChange(const MultiFab& old_coef, const MultiFab& new_coef)
+{
+  MultiFab diff(old_coef.boxArray(), old_coef.DistributionMap(), 1, 0);
+  MultiFab::LinComb(diff, 1.0, new_coef, 0, -1.0, old_coef, 0, 0, 1, 0);
+
+  const Real dnorm = diff.norm0();
+  const Real onorm = old_coef.norm0();
+
+  if (onorm > 0.0) {
+    return dnorm / onorm;
+  }
+  else {
+    return (dnorm > 0.0) ? 1.e200 : 0.0;
+  }
+}
+
 Real HypreABec::flux_factor = 1.0;
 
 #if (BL_SPACEDIM == 1)
@@ -57,6 +76,14 @@ HypreABec::HypreABec(const BoxArray& grids,
   pfmg_relax_type = 1; pp.query("pfmg_relax_type", pfmg_relax_type);
   verbose = 0; pp.query("v", verbose); pp.query("verbose", verbose);
   verbose_threshold = 0; pp.query("verbose_threshold", verbose_threshold);
+  lag_precond = 0; pp.query("lag_precond", lag_precond);
+  lag_iter_growth = 2.0; pp.query("lag_iter_growth", lag_iter_growth);
+
+  // A stale setup is only safe as a preconditioner for a Krylov
+  // method; SMG, PFMG and Jacobi use it as the solver itself.
+  if (solver_flag < 3) {
+    lag_precond = 0;
+  }
 
   static int first = 1;
   if (verbose >= 1 && first && ParallelDescriptor::IOProcessor()) {
@@ -66,6 +93,10 @@ HypreABec::HypreABec(const BoxArray& grids,
     }
     std::cout << "habec.verbose                   = " << verbose << std::endl;
     std::cout << "habec.verbose_threshold         = " << verbose_threshold << std::endl;
+    if (lag_precond > 0) {
+      std::cout << "habec.lag_precond               = " << lag_precond << std::endl;
+      std::cout << "habec.lag_iter_growth           = " << lag_iter_growth << std::endl;
+    }
   }
   bho = 0; // higher order boundaries don't work with symmetric matrices
 
@@ -205,6 +236,10 @@ HypreABec::HypreABec(const BoxArray& grids,
 
 HypreABec::~HypreABec()
 {
+  if (solver_is_setup) {
+    clearSolver();
+  }
+
   HYPRE_StructVectorDestroy(b);
   HYPRE_StructVectorDestroy(x);
 
@@ -216,6 +251,9 @@ HypreABec::~HypreABec()
 
 void HypreABec::setScalars(Real Alpha, Real Beta)
 {
+  if (solver_is_setup && (Alpha != alpha || Beta != beta)) {
+    coef_change = 1.e200;
+  }
   alpha = Alpha;
   beta  = Beta;
 }
@@ -224,6 +262,9 @@ void HypreABec::aCoefficients(const MultiFab &a)
 {
   BL_ASSERT( a.ok() );
   BL_ASSERT( a.boxArray() == acoefs->boxArray() );
+  if (solver_is_setup) {
+    coef_change = std::max(coef_change, relChange(*acoefs, a));
+  }
   MultiFab::Copy(*acoefs, a, 0, 0, 1, 0);
 }
  
@@ -231,6 +272,9 @@ void HypreABec::bCoefficients(const MultiFab &b, int dir)
 {
   BL_ASSERT( b.ok() );
   BL_ASSERT( b.boxArray() == bcoefs[dir]->boxArray() );
+  if (solver_is_setup) {
+    coef_change = std::max(coef_change, relChange(*bcoefs[dir], b));
+  }
   MultiFab::Copy(*bcoefs[dir], b, 0, 0, 1, 0);
 }
 
@@ -242,6 +286,9 @@ void HypreABec::SPalpha(const MultiFab& a)
     const DistributionMapping& dmap = a.DistributionMap();
     SPa.reset(new MultiFab(grids,dmap,1,0));
   }
+  else if (solver_is_setup) {
+    coef_change = std::max(coef_change, relChange(*SPa, a));
+  }
   MultiFab::Copy(*SPa, a, 0, 0, 1, 0);
 }
 
@@ -916,9 +963,9 @@ void HypreABec::hbmat3 (const Box& bx,
     Gpu::synchronize();
 }
 
-void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
+void HypreABec::loadMatrix()
 {
-  BL_PROFILE("HypreABec::setupSolver");
+  BL_PROFILE("HypreABec::loadMatrix");
 
   const BoxArray& grids = acoefs->boxArray();
 
@@ -998,6 +1045,92 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
 
   HYPRE_StructMatrixAssemble(A);
 
+  coef_change = 0.0;
+
+  saveBndry();
+}
+
+Vector<Real> HypreABec::bndryDescriptor()
+{
+  // Everything about the boundary conditions that goes into the
+  // matrix, for the boxes on this rank
+
+  const NGBndry& bd = getBndry();
+
+  Vector<Real> desc;
+  desc.push_back(flux_factor);
+  desc.push_back(bdcomp);
+
+  for (OrientationIter oitr; oitr; oitr++) {
+    desc.push_back(bd.mixedBndry(oitr()));
+
+    for (MFIter ai(*acoefs); ai.isValid(); ++ai) {
+      const int i = ai.index();
+
+      desc.push_back(bd.bndryConds(oitr())[i]);
+      desc.push_back(bd.bndryLocs(oitr())[i]);
+
+      if (bd.mixedBndry(oitr())) {
+        const BaseFab<int>& tf = *(bd.bndryTypes(oitr())[i]);
+        desc.push_back(tf.sum<RunOn::Host>(0));
+      }
+    }
+  }
+
+  return desc;
+}
+
+void HypreABec::saveBndry()
+{
+  const NGBndry& bd = getBndry();
+
+  bndry_desc = bndryDescriptor();
+
+  for (OrientationIter oitr; oitr; oitr++) {
+    const MultiFab& bv = bd.bndryValues(oitr()).multiFab();
+    bndry_vals[oitr()].reset(new MultiFab(bv.boxArray(), bv.DistributionMap(), 1, 0));
+    MultiFab::Copy(*bndry_vals[oitr()], bv, bdcomp, 0, 1, 0);
+  }
+}
+
+Real HypreABec::bndryChange()
+{
+  const NGBndry& bd = getBndry();
+
+  // the decision to rebuild the solver must be the same on every rank
+
+  int desc_changed = (bndryDescriptor() != bndry_desc) ? 1 : 0;
+  ParallelDescriptor::ReduceIntMax(desc_changed);
+
+  if (desc_changed) {
+    return 1.e200;
+  }
+
+  Real change = 0.0;
+
+  for (OrientationIter oitr; oitr; oitr++) {
+    const MultiFab& bv = bd.bndryValues(oitr()).multiFab();
+
+    if (bndry_vals[oitr()] == nullptr ||
+        bndry_vals[oitr()]->boxArray() != bv.boxArray()) {
+      return 1.e200;
+    }
+
+    MultiFab cur(bv.boxArray(), bv.DistributionMap(), 1, 0);
+    MultiFab::Copy(cur, bv, bdcomp, 0, 1, 0);
+
+    change = std::max(change, relChange(*bndry_vals[oitr()], cur));
+  }
+
+  return change;
+}
+
+void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
+{
+  BL_PROFILE("HypreABec::setupSolver");
+
+  loadMatrix();
+
   HYPRE_StructVectorAssemble(b); // currently a no-op
   HYPRE_StructVectorAssemble(x); // currently a no-op
 
@@ -1132,6 +1265,9 @@ void HypreABec::setupSolver(Real _reltol, Real _abstol, int maxiter)
       amrex::Error("HypreABec: no such solver");
   }
   Gpu::synchronize();
+
+  solver_is_setup = true;
+  solves_since_setup = 0;
 }
 
 void HypreABec::clearSolver()
@@ -1167,6 +1303,45 @@ void HypreABec::clearSolver()
        HYPRE_StructSMGDestroy(precond);
     }
   }
+
+  solver_is_setup = false;
+}
+
+bool HypreABec::lagExpired() const
+{
+  if (lag_precond <= 0 || !solver_is_setup) {
+    return true;
+  }
+
+  if (solves_since_setup >= lag_precond) {
+    return true;
+  }
+
+  return (solves_since_setup > 0 &&
+          last_iterations > lag_iter_growth * std::max(setup_iterations, 1));
+}
+
+int HypreABec::getNumIterations()
+{
+  int num_iterations = 0;
+
+  if (solver_flag == 0) {
+    HYPRE_StructSMGGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 1) {
+    HYPRE_StructPFMGGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 2) {
+    HYPRE_StructJacobiGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 3 || solver_flag == 4) {
+    HYPRE_StructPCGGetNumIterations(solver, &num_iterations);
+  }
+  else if(solver_flag == 5 || solver_flag == 6) {
+    HYPRE_StructHybridGetNumIterations(solver, &num_iterations);
+  }
+
+  return num_iterations;
 }
 
 void HypreABec::hbvec3 (const Box& bx,
@@ -1796,19 +1971,22 @@ void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
                        ? abstol / bnorm * sqrt(volume)
                        : reltol);
 
-    if (reltol_new > reltol) {
-      if (solver_flag == 0) {
-        HYPRE_StructSMGSetTol(solver, reltol_new);
-      }
-      else if(solver_flag == 1) {
-        HYPRE_StructPFMGSetTol(solver, reltol_new);
-      }
-      else if(solver_flag == 2) {
-        // nothing for this option
-      }
-      else if(solver_flag == 3 || solver_flag == 4) {
-        HYPRE_StructPCGSetTol(solver, reltol_new);
-      }
+    // Always set the tolerance, since a solver that is reused across
+    // solves may still hold a looser one from an earlier rhs.
+
+    reltol_new = std::max(reltol_new, reltol);
+
+    if (solver_flag == 0) {
+      HYPRE_StructSMGSetTol(solver, reltol_new);
+    }
+    else if(solver_flag == 1) {
+      HYPRE_StructPFMGSetTol(solver, reltol_new);
+    }
+    else if(solver_flag == 2) {
+      // nothing for this option
+    }
+    else if(solver_flag == 3 || solver_flag == 4) {
+      HYPRE_StructPCGSetTol(solver, reltol_new);
     }
   }
 
@@ -1833,6 +2011,15 @@ void HypreABec::solve(MultiFab& dest, int icomp, MultiFab& rhs, BC_Mode inhom)
 
   Gpu::synchronize();
 
+  // iteration history for the lagged preconditioner
+  if (lag_precond > 0) {
+    last_iterations = getNumIterations();
+    if (solves_since_setup == 0) {
+      setup_iterations = last_iterations;
+    }
+  }
+  solves_since_setup++;
+
   for (MFIter di(dest); di.isValid(); ++di) {
     i = di.index();
     const Box &reg = grids[i];
@@ -161,6 +161,7 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
   }
 
   RadSolve* const solver = castro->rad_solver.get();
+  solver->resetSolverTimers();
 
   Real relative_in, absolute_in, error_er;
   Real rel_rhoe, abs_rhoe;
@@ -267,6 +268,10 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
 
         set_current_group(igroup);
 
+        // with radsolve.batch_groups, each group has its own solver,
+        // whose setup is kept from one inner iteration to the next
+        solver->setActiveGroup(igroup);
+
         // setup and solve linear system
 
         // set boundary condition
@@ -301,6 +306,8 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
             solver->levelFluxFaceToCenter(level, Flux, *flxcc, icomp_flux+igroup);
 
       } // end loop over groups
+
+      solver->setActiveGroup(-1);
       
       // Check for convergence *before* acceleration step:
       check_convergence_er(relative_in, absolute_in, error_er, Er_new, Er_pi,
@@ -574,6 +581,7 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
   }
 
   if (verbose) {
+      solver->printSolverTimers(level);
       amrex::Print() << "                                     done" << std::endl;
   }
 }
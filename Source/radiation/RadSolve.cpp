@@ -25,6 +25,16 @@ RadSolve::RadSolve (Amr* Parent, int level, const BoxArray& grids, const Distrib
 
     if (radsolve::level_solver_flag < 100) {
         hd.reset(new HypreABec(grids, dmap, parent->Geom(level), radsolve::level_solver_flag));
+
+        if (radsolve::batch_groups == 1 &&
+            Radiation::SolverType == Radiation::MGFLDSolver && Radiation::nGroups > 1) {
+            // slot 0 is left empty, since the ungrouped solver starts out active
+            hd_group.resize(Radiation::nGroups + 1);
+            for (int igroup = 0; igroup < Radiation::nGroups; igroup++) {
+                hd_group[igroup+1].reset(new HypreABec(grids, dmap, parent->Geom(level),
+                                                       radsolve::level_solver_flag));
+            }
+        }
     }
     else {
         if (radsolve::use_hypre_nonsymmetric_terms == 0) {
@@ -572,9 +582,54 @@ void RadSolve::levelSolve(int level,
     hem->setScalars(radsolve::alpha, radsolve::beta);
   }
 
+  Real strt = ParallelDescriptor::second();
+
   if (hd) {
-    hd->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+    // A batched group solver keeps its setup between solves; it is
+    // only rebuilt if the coefficients or the boundary data changed by
+    // more than the tolerance.  A lagged preconditioner is kept until
+    // it expires.  When the setup is kept we just refill the matrix
+    // values.  An older setup is only used as a preconditioner: for
+    // SMG, PFMG and Jacobi the setup is the solver, so it is only kept
+    // if the matrix is unchanged.
+    const bool batched = (active_group >= 0);
+    const bool keep_solver = batched || hd->lagPrecond() > 0;
+
+    bool reuse = false;
+    Real change = 0.0;
+    if (hd->solverIsSetup()) {
+      change = std::max(hd->coefficientChange(), hd->bndryChange());
+
+      const Real tol = hd->hasPreconditioner() ? radsolve::batch_coef_tol : 0.0;
+
+      if (batched && change <= tol) {
+        reuse = true;
+      }
+      if (hd->lagPrecond() > 0 && !hd->lagExpired()) {
+        reuse = true;
+      }
+    }
+
+    if (reuse) {
+      if (change > 0.0) {
+        hd->loadMatrix();
+      }
+    }
+    else {
+      if (hd->solverIsSetup()) {
+        hd->clearSolver();
+      }
+      hd->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+      num_setups++;
+    }
+
+    setup_time += ParallelDescriptor::second() - strt;
+    strt = ParallelDescriptor::second();
+
     hd->solve(Er, igroup, rhs, Inhomogeneous_BC);
+
+    solve_time += ParallelDescriptor::second() - strt;
+
     Real res = hd->getAbsoluteResidual();
     if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
       int oldprec = std::cout.precision(20);
@@ -582,7 +637,9 @@ void RadSolve::levelSolve(int level,
       std::cout.precision(oldprec);
     }
     res *= sync_absres_factor;
-    hd->clearSolver();
+    if (!keep_solver) {
+      hd->clearSolver();
+    }
   }
   else if (hm) {
     hm->loadMatrix();
@@ -590,7 +647,11 @@ void RadSolve::levelSolve(int level,
     hm->loadLevelVectors(level, Er, igroup, rhs, Inhomogeneous_BC);
     hm->finalizeVectors();
     hm->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+    num_setups++;
+    setup_time += ParallelDescriptor::second() - strt;
+    strt = ParallelDescriptor::second();
     hm->solve();
+    solve_time += ParallelDescriptor::second() - strt;
     hm->getSolution(level, Er, igroup);
     Real res = hm->getAbsoluteResidual();
     if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
@@ -607,7 +668,11 @@ void RadSolve::levelSolve(int level,
     hem->loadLevelVectors(level, Er, igroup, rhs, Inhomogeneous_BC);
     hem->finalizeVectors();
     hem->setupSolver(radsolve::reltol, radsolve::abstol, radsolve::maxiter);
+    num_setups++;
+    setup_time += ParallelDescriptor::second() - strt;
+    strt = ParallelDescriptor::second();
     hem->solve();
+    solve_time += ParallelDescriptor::second() - strt;
     hem->getSolution(level, Er, igroup);
     Real res = hem->getAbsoluteResidual();
     if (verbose >= 2 && ParallelDescriptor::IOProcessor()) {
@@ -618,6 +683,50 @@ void RadSolve::levelSolve(int level,
     res *= sync_absres_factor;
     hem->clearSolver();
   }
+
+  num_solves++;
+}
+
+void RadSolve::resetSolverTimers()
+{
+  setup_time = 0.0;
+  solve_time = 0.0;
+  num_setups = 0;
+  num_solves = 0;
+}
+
+void RadSolve::printSolverTimers(int level)
+{
+  const int IOProc = ParallelDescriptor::IOProcessorNumber();
+
+  Real times[2] = {setup_time, solve_time};
+  const int nsetups = num_setups;
+  const int nsolves = num_solves;
+
+  ParallelDescriptor::ReduceRealMax(times, 2, IOProc);
+
+  if (ParallelDescriptor::IOProcessor()) {
+    std::cout << "RadSolve level " << level << ": "
+              << nsetups << " hypre setups, " << nsolves << " solves; "
+              << "setup time = " << times[0] << ", "
+              << "solve time = " << times[1] << std::endl;
+  }
+}
+
+void RadSolve::setActiveGroup(int igroup)
+{
+  if (hd_group.empty() || igroup == active_group) {
+    return;
+  }
+
+  BL_ASSERT(igroup >= -1 && igroup+1 < static_cast<int>(hd_group.size()));
+
+  // return the active solver to its slot, then take out the new one
+
+  hd_group[active_group+1].swap(hd);
+  hd.swap(hd_group[igroup+1]);
+
+  active_group = igroup;
 }
 
 void RadSolve::levelFluxFaceToCenter(int level, const Array<MultiFab, BL_SPACEDIM>& Flux,
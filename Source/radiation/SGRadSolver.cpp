@@ -145,6 +145,7 @@ void Radiation::single_group_update(int level, int iteration, int ncycle)
       (level > 0) ? flux_trial[level].get() : nullptr;
 
   RadSolve* const solver = castro->rad_solver.get();
+  solver->resetSolverTimers();
 
   solver->levelBndry(bd);
 
@@ -410,6 +411,10 @@ void Radiation::single_group_update(int level, int iteration, int ncycle)
       }
   }
 
+  if (verbose) {
+    solver->printSolverTimers(level);
+  }
+
   if (verbose && ParallelDescriptor::IOProcessor()) {
     std::cout << "                                     done" << std::endl;
   }
@@ -62,8 +62,12 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
         amrex::Print() << "... Entering burner and doing half-timestep of burning." << std::endl << std::endl;
     }
 
-    ReduceOps<ReduceOpSum> reduce_op;
-    ReduceData<Real> reduce_data(reduce_op);
+    // Number of substeps to use when retrying a failed burn in a single zone.
+
+    const int nsub_local = castro::retry_burn_local_subcycles;
+
+    ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
+    ReduceData<Real, Real> reduce_data(reduce_op);
     using ReduceTuple = typename decltype(reduce_data)::Type;
 
 #ifdef _OPENMP
@@ -90,6 +94,7 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
                 bool do_burn = true;
                 burn_state.success = true;
                 Real burn_failed = 0.0_rt;
+                Real burn_retried = 0.0_rt;
 
                 // Don't burn on zones inside shock regions, if the relevant option is set.
 
@@ -131,6 +136,65 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
                     burner(burn_state, dt);
                 }
 
+                // If the burn failed, try again in this zone only, breaking
+                // the burn into several shorter burns. The burn is local to
+                // the zone, so this does not affect any other zone, and it
+                // saves us from having to retry the advance on the whole level.
+
+                if (do_burn && !burn_state.success && nsub_local > 0) {
+
+                    burn_retried = 1.0_rt;
+
+                    burn_state.rho = U(i,j,k,URHO);
+                    burn_state.T   = U(i,j,k,UTEMP);
+                    burn_state.e   = 0.0_rt;
+
+                    for (int n = 0; n < NumSpec; ++n) {
+                        burn_state.xn[n] = U(i,j,k,UFS+n) * rhoInv;
+                    }
+
+#if NAUX_NET > 0
+                    for (int n = 0; n < NumAux; ++n) {
+                        burn_state.aux[n] = U(i,j,k,UFX+n) * rhoInv;
+                    }
+#endif
+
+                    int n_rhs = burn_state.n_rhs;
+                    int n_jac = burn_state.n_jac;
+
+                    // Each substep reports only its own energy release,
+                    // so we sum them to get the release over dt.
+
+                    Real e_release = 0.0_rt;
+
+                    const Real dt_sub = dt / static_cast<Real>(nsub_local);
+
+                    burn_state.success = true;
+
+                    for (int isub = 0; isub < nsub_local; ++isub) {
+
+                        burn_state.n_rhs = 0;
+                        burn_state.n_jac = 0;
+                        burn_state.e = 0.0_rt;
+
+                        burner(burn_state, dt_sub);
+
+                        n_rhs += burn_state.n_rhs;
+                        n_jac += burn_state.n_jac;
+                        e_release += burn_state.e;
+
+                        if (!burn_state.success) {
+                            break;
+                        }
+
+                    }
+
+                    burn_state.n_rhs = n_rhs;
+                    burn_state.n_jac = n_jac;
+                    burn_state.e = e_release;
+
+                }
+
                 // If we were unsuccessful, update the failure count.
 
                 if (!burn_state.success) {
@@ -169,7 +233,7 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
 
                 }
 
-                return {burn_failed};
+                return {burn_failed, burn_retried};
 
             });
 
@@ -198,6 +262,7 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
 
     ReduceTuple hv = reduce_data.value();
     Real burn_failed = amrex::get<0>(hv);
+    Real burn_retried = amrex::get<1>(hv);
 
     if (burn_failed != 0.0) {
       burn_success = 0;
@@ -205,6 +270,17 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt)
 
     ParallelDescriptor::ReduceIntMin(burn_success);
 
+    if (nsub_local > 0 && verbose > 0) {
+
+        ParallelDescriptor::ReduceRealSum(burn_retried);
+
+        if (burn_retried > 0.0) {
+            amrex::Print() << "... Retried the burn in " << static_cast<long>(burn_retried)
+                           << " zones with " << nsub_local << " substeps" << std::endl << std::endl;
+        }
+
+    }
+
     if (print_update_diagnostics) {
 
         Real e_added = r.sum(NumSpec + 1);
@@ -5,12 +5,28 @@
 
 using namespace amrex;
 
+// The cost of the implicit reaction solve varies a lot from zone to
+// zone, so on the CPU we tile and hand out the tiles to threads
+// dynamically.
+
+static MFItInfo
+sdc_mfi_info ()
+{
+    MFItInfo info;
+    if (Gpu::notInLaunchRegion()) {
+        info.EnableTiling().SetDynamic(true);
+    }
+    return info;
+}
+
 void
 Castro::do_sdc_update(int m_start, int m_end, Real dt)
 {
 
     BL_PROFILE("Castro::do_sdc_update()");
 
+    const Real strt_time = ParallelDescriptor::second();
+
     // NOTE: dt here is the full dt not the dt between time nodes
 
     // this routine needs to do the update from time node m to m+1
@@ -41,10 +57,15 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
     if (sdc_order == 4)
     {
 
+        BL_PROFILE_VAR("Castro::do_sdc_update()::C_source", sdc_C_source);
+
         // for 4th order reacting flow, we need to create the "source" C
         // as averages and then convert it to cell centers.  The cell-center
         // version needs to have 2 ghost cells
-        for (MFIter mfi(*k_new[0]); mfi.isValid(); ++mfi)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(*k_new[0], TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
 
             const Box& bx = mfi.tilebox();
@@ -85,13 +106,19 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
         AmrLevel::FillPatch(*this, C_source, C_source.nGrow(), time,
                             SDC_Source_Type, 0, NUM_STATE);
 
+        BL_PROFILE_VAR_STOP(sdc_C_source);
+
+        BL_PROFILE_VAR("Castro::do_sdc_update()::initial_guess", sdc_initial_guess);
 
         // we'll also construct an initial guess for the nonlinear solve,
         // and store this in the Sburn MultiFab.  We'll use S_new as the
         // staging place so we can do a FillPatch
         MultiFab& S_new = get_new_data(State_Type);
 
-        for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
 
             const Box& bx = mfi.tilebox();
@@ -114,25 +141,42 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
         const Real cur_time = state[State_Type].curTime();
         expand_state(Sburn, cur_time, 2);
 
+        BL_PROFILE_VAR_STOP(sdc_initial_guess);
+
     }
 #endif
 
     // main update loop -- we are updating k_new[m_start] to
     // k_new[m_end]
 
+    BL_PROFILE_VAR("Castro::do_sdc_update()::node_update", sdc_node_update);
+
+#ifdef REACTIONS
+    // for 4th order, the cell-center reaction source at the new node,
+    // including one ghost cell.  Each tile fills its own part of this,
+    // and we convert it to averages once all of the tiles are done.
+    MultiFab R_node;
+    if (sdc_order == 4)
+    {
+        R_node.define(grids, dmap, NUM_STATE, 1);
+    }
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+
     FArrayBox U_center;
     FArrayBox C_center;
     FArrayBox U_new_center;
-    FArrayBox R_new;
-    FArrayBox tlap;
 
     FArrayBox C2;
 
-    for (MFIter mfi(*k_new[0]); mfi.isValid(); ++mfi)
+    for (MFIter mfi(*k_new[0], sdc_mfi_info()); mfi.isValid(); ++mfi)
     {
 
         const Box& bx = mfi.tilebox();
-        const Box& bx1 = mfi.growntilebox(1);
 
 #ifdef REACTIONS
         // advection + reactions
@@ -198,12 +242,11 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
         {
 
             // fourth order SDC reaction update -- we need to respect the
-            // difference between cell-centers and averages
+            // difference between cell-centers and averages.  Each zone,
+            // including the ghost cell around the box, is solved by
+            // exactly one tile.
 
-            Array4<const Real> const& k_new_m_start_arr=
-                (k_new[m_start])->array(mfi);
-            Array4<Real> const& k_new_m_end_arr=(k_new[m_end])->array(mfi);
-            Array4<const Real> const& C_source_arr=C_source.array(mfi);
+            const Box& bx1 = mfi.growntilebox(1);
 
             // convert the starting U to cell-centered on a fab-by-fab basis
             // -- including one ghost cell
@@ -245,11 +288,9 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
                 sdc_update_centers_o4(i, j, k, U_center_arr, U_new_center_arr, C_center_arr, dt_m, sdc_iteration);
             });
 
-            // compute R_i and in 1 ghost cell and then convert to <R> in
-            // place (only for the interior)
-            R_new.resize(bx1, NUM_STATE);
-            Elixir elix_R_new = R_new.elixir();
-            Array4<Real> const& R_new_arr = R_new.array();
+            // compute R_i and in 1 ghost cell -- this is converted to <R>
+            // after all the tiles are done
+            Array4<Real> const& R_new_arr = R_node.array(mfi);
 
             // ca_instantaneous_react(BL_TO_FORTRAN_BOX(bx1),
             //                        BL_TO_FORTRAN_3D(U_new_center),
@@ -260,17 +301,6 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
                 instantaneous_react(i, j, k, U_new_center_arr, R_new_arr);
             });
 
-            tlap.resize(bx, 1);
-            Elixir elix_tlap = tlap.elixir();
-            auto const tlap_arr = tlap.array();
-
-            make_fourth_in_place(bx, R_new_arr, tlap_arr, domain_lo, domain_hi);
-
-            // now do the conservative update using this <R> to get <U>
-            // We'll also need to pass in <C>
-            ca_sdc_conservative_update(bx, dt_m, k_new_m_start_arr, k_new_m_end_arr,
-                                       C_source_arr, R_new_arr);
-
         }
 #else
         Array4<const Real> const& k_new_m_start_arr=
@@ -327,6 +357,59 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
 #endif
 
     }
+
+    } // end of omp parallel region
+
+#ifdef REACTIONS
+    if (sdc_order == 4)
+    {
+        // convert R to <R> (only for the interior) -- this reads the
+        // neighboring tiles, so it needs all of them to be done
+
+        make_fourth_in_place(R_node, 0);
+
+        // now do the conservative update using this <R> to get <U>
+        // We'll also need to pass in <C>
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(*k_new[0], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+
+            const Box& bx = mfi.tilebox();
+
+            Array4<const Real> const& k_new_m_start_arr=
+                (k_new[m_start])->array(mfi);
+            Array4<Real> const& k_new_m_end_arr=(k_new[m_end])->array(mfi);
+            Array4<const Real> const& C_source_arr=C_source.array(mfi);
+            Array4<const Real> const& R_node_arr=R_node.array(mfi);
+
+            ca_sdc_conservative_update(bx, dt_m, k_new_m_start_arr, k_new_m_end_arr,
+                                       C_source_arr, R_node_arr);
+        }
+    }
+#endif
+
+    BL_PROFILE_VAR_STOP(sdc_node_update);
+
+    if (verbose > 1)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+
+        if (ParallelDescriptor::IOProcessor())
+          std::cout << "Castro::do_sdc_update() node " << m_start << " -> " << m_end
+                    << " time = " << run_time << "\n";
+#ifdef BL_LAZY
+        });
+#endif
+    }
 }
 
 
@@ -345,16 +428,21 @@ Castro::construct_old_react_source(MultiFab& U_state,
     if (sdc_order == 4 && input_is_average)
     {
         // we have cell-averages
-        // Note: we cannot tile these operations
+
+        // the cell-center reaction source, including one ghost cell.
+        // Each zone is burned by exactly one tile.
+        MultiFab R_center(grids, dmap, NUM_STATE, 1);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
 
         FArrayBox U_center;
-        FArrayBox R_center;
-        FArrayBox tmp;
 
-        for (MFIter mfi(U_state); mfi.isValid(); ++mfi)
+        for (MFIter mfi(U_state, sdc_mfi_info()); mfi.isValid(); ++mfi)
         {
 
-            const Box& bx = mfi.tilebox();
             const Box& obx = mfi.growntilebox(1);
 
             // Convert to centers
@@ -365,9 +453,7 @@ Castro::construct_old_react_source(MultiFab& U_state,
             make_cell_center(obx, U_state.array(mfi), U_center_arr, domain_lo, domain_hi);
 
             // burn, including one ghost cell
-            R_center.resize(obx, NUM_STATE);
-            Elixir elix_r_center = R_center.elixir();
-            auto const R_center_arr = R_center.array();
+            auto const R_center_arr = R_center.array(mfi);
 
             // ca_instantaneous_react(BL_TO_FORTRAN_BOX(obx),
             //                        BL_TO_FORTRAN_3D(U_center),
@@ -377,30 +463,30 @@ Castro::construct_old_react_source(MultiFab& U_state,
             {
                 instantaneous_react(i, j, k, U_center_arr, R_center_arr);
             });
+        }
 
-            // at this point, we have the reaction term on centers,
-            // including a ghost cell.  Save this into Sburn so we can use
-            // it later for the plotfile filling
-            Sburn[mfi].copy(R_center, obx, 0, obx, 0, NUM_STATE);
-
-            // convert R to averages (in place)
+        } // end of omp parallel region
 
-            tmp.resize(bx, 1);
-            Elixir elix_tmp = tmp.elixir();
-            auto const tmp_arr = tmp.array();
+        // at this point, we have the reaction term on centers,
+        // including a ghost cell.  Save this into Sburn so we can use
+        // it later for the plotfile filling.  U_state may be Sburn
+        // itself, so this waits until all of the tiles have read it.
+        MultiFab::Copy(Sburn, R_center, 0, 0, NUM_STATE, 1);
 
-            make_fourth_in_place(bx, R_center_arr, tmp_arr, domain_lo, domain_hi);
+        // convert R to averages (in place) and copy this to the center
+        make_fourth_in_place(R_center, 0);
 
-            // copy this to the center
-            R_source[mfi].copy(R_center, bx, 0, bx, 0, NUM_STATE);
-        }
+        MultiFab::Copy(R_source, R_center, 0, 0, NUM_STATE, 0);
 
     }
     else
     {
         // we are cell-centers
 
-        for (MFIter mfi(U_state); mfi.isValid(); ++mfi)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(U_state, sdc_mfi_info()); mfi.isValid(); ++mfi)
         {
 
             const Box& bx = mfi.tilebox();
@@ -103,6 +103,190 @@ Castro::source_flag(int src)
     } // end switch
 }
 
+bool
+Castro::source_is_fused(int src, bool is_new)
+{
+    // Only sources that are purely local to a zone (given the gravity
+    // and rotation fields, which are computed beforehand) can be fused.
+    // The new-time sponge source changes the sponge parameters partway
+    // through, so it is done on its own.
+
+    switch(src) {
+
+#ifdef GRAVITY
+    case grav_src:
+        return do_grav;
+#endif
+
+#ifdef ROTATION
+    case rot_src:
+        return do_rotation;
+#endif
+
+#ifdef SPONGE
+    case sponge_src:
+        return do_sponge && !is_new;
+#endif
+
+    default:
+        return false;
+
+    } // end switch
+}
+
+void
+Castro::construct_old_fused_sources(MultiFab& source, MultiFab& state_in, Real time, Real dt)
+{
+    BL_PROFILE("Castro::construct_old_fused_sources()");
+
+    const Real strt_time = ParallelDescriptor::second();
+
+    // Do the setup that each source needs before we loop over the zones.
+
+#ifdef GRAVITY
+    const bool fuse_grav = source_is_fused(grav_src, false);
+    const MultiFab& grav_old = get_old_data(Gravity_Type);
+
+    if (fuse_grav) {
+        AMREX_ALWAYS_ASSERT(castro::grav_source_type >= 1 && castro::grav_source_type <= 4);
+    }
+#endif
+
+#ifdef ROTATION
+    const bool fuse_rot = source_is_fused(rot_src, false);
+
+    if (fuse_rot) {
+        fill_rotation_field(get_old_data(PhiRot_Type), state_in, time);
+    }
+#endif
+
+#ifdef SPONGE
+    const bool fuse_sponge = source_is_fused(sponge_src, false);
+
+    if (fuse_sponge) {
+        update_sponge_params(&time);
+    }
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(state_in, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+#ifdef GRAVITY
+        if (fuse_grav) {
+            gsrc(bx, state_in.array(mfi), grav_old.array(mfi), source.array(mfi), dt);
+        }
+#endif
+
+#ifdef ROTATION
+        if (fuse_rot) {
+            rsrc(bx, state_in.array(mfi), source.array(mfi), dt);
+        }
+#endif
+
+#ifdef SPONGE
+        if (fuse_sponge) {
+            apply_sponge(bx, state_in.array(mfi), source.array(mfi), dt, 1.0);
+        }
+#endif
+    }
+
+    if (verbose > 1)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+
+        if (ParallelDescriptor::IOProcessor())
+          std::cout << "Castro::construct_old_fused_sources() time = " << run_time << "\n" << "\n";
+#ifdef BL_LAZY
+        });
+#endif
+    }
+}
+
+void
+Castro::construct_new_fused_sources(MultiFab& source, MultiFab& state_old, MultiFab& state_new, Real time, Real dt)
+{
+    BL_PROFILE("Castro::construct_new_fused_sources()");
+
+    const Real strt_time = ParallelDescriptor::second();
+
+#ifdef GRAVITY
+    const bool fuse_grav = source_is_fused(grav_src, true);
+    const MultiFab& grav_old = get_old_data(Gravity_Type);
+    const MultiFab& grav_new = get_new_data(Gravity_Type);
+
+    if (fuse_grav) {
+        AMREX_ALWAYS_ASSERT(castro::grav_source_type >= 1 && castro::grav_source_type <= 4);
+    }
+#endif
+
+#ifdef ROTATION
+    const bool fuse_rot = source_is_fused(rot_src, true);
+    const MultiFab& phirot_old = get_old_data(PhiRot_Type);
+    MultiFab& phirot_new = get_new_data(PhiRot_Type);
+
+    if (fuse_rot) {
+        fill_rotation_field(phirot_new, state_new, time);
+    }
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(state_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+#ifdef GRAVITY
+        if (fuse_grav) {
+            corrgsrc(bx,
+                     state_old.array(mfi), state_new.array(mfi),
+                     grav_old.array(mfi), grav_new.array(mfi),
+                     source.array(mfi),
+                     (*mass_fluxes[0]).array(mfi), (*mass_fluxes[1]).array(mfi), (*mass_fluxes[2]).array(mfi),
+                     dt, volume.array(mfi));
+        }
+#endif
+
+#ifdef ROTATION
+        if (fuse_rot) {
+            corrrsrc(bx,
+                     phirot_old.array(mfi), phirot_new.array(mfi),
+                     state_old.array(mfi), state_new.array(mfi),
+                     source.array(mfi),
+                     (*mass_fluxes[0]).array(mfi), (*mass_fluxes[1]).array(mfi), (*mass_fluxes[2]).array(mfi),
+                     dt, volume.array(mfi));
+        }
+#endif
+    }
+
+    if (verbose > 1)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+
+        if (ParallelDescriptor::IOProcessor())
+          std::cout << "Castro::construct_new_fused_sources() time = " << run_time << "\n" << "\n";
+#ifdef BL_LAZY
+        });
+#endif
+    }
+}
+
 void
 Castro::do_old_sources(
 #ifdef MHD
@@ -126,7 +310,20 @@ Castro::do_old_sources(
         temp_source.setVal(0.0, NUM_GROW);
     }
 
+    // Optionally evaluate the cell-local sources together, tile by tile.
+
+    const bool fuse = fuse_sources && !(apply_sources_consecutively && apply_to_state);
+
+    if (fuse) {
+        construct_old_fused_sources(source, state_old, time, dt);
+    }
+
     for (int n = 0; n < num_src; ++n) {
+
+        if (fuse && source_is_fused(n, false)) {
+            continue;
+        }
+
         construct_old_source(n, source, state_old, time, dt);
 
         // We can either apply the sources to the state one by one, or we can
@@ -218,9 +415,21 @@ Castro::do_new_sources(
         temp_source.setVal(0.0, NUM_GROW);
     }
 
-    // Construct the new-time source terms.
+    // Construct the new-time source terms, optionally evaluating
+    // the cell-local sources together, tile by tile.
+
+    const bool fuse = fuse_sources && !(apply_sources_consecutively && apply_to_state);
+
+    if (fuse) {
+        construct_new_fused_sources(source, state_old, state_new, time, dt);
+    }
 
     for (int n = 0; n < num_src; ++n) {
+
+        if (fuse && source_is_fused(n, true)) {
+            continue;
+        }
+
         construct_new_source(n, source, state_old, state_new, time, dt);
 
         // We can either apply the sources to the state one by one, or we can